@@ -16,7 +16,11 @@ public class GammaGoo : ModuleRules
 			"InputCore",
 			"EnhancedInput",
 			"RenderCore",
-			"RHI"
+			"RHI",
+			"Niagara",
+			"NiagaraCore",
+			"NiagaraShader",
+			"VectorVM"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]
@@ -24,8 +28,8 @@ public class GammaGoo : ModuleRules
 			"Slate",
 			"SlateCore",
 			"UMG",
-			"Niagara",
-			"GameplayTags"
+			"GameplayTags",
+			"Landscape"
 		});
 	}
 }
@@ -0,0 +1,129 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidArena.h"
+#include "Misc/ScopeLock.h"
+
+#if PLATFORM_LINUX
+#include <sys/mman.h>
+
+namespace
+{
+	constexpr SIZE_T HugePageSize = 2 * 1024 * 1024;
+}
+#endif
+
+FCriticalSection FFluidArena::PoolLock;
+FFluidArena::FBlock FFluidArena::PooledBlock;
+
+void FFluidArena::Commit(bool bUseHugePages)
+{
+	check(!Block && LayoutSize > 0);
+
+	FBlock Taken;
+	{
+		FScopeLock Lock(&PoolLock);
+		if (PooledBlock.Data && PooledBlock.Size >= LayoutSize && PooledBlock.bHugePages == bUseHugePages)
+		{
+			Taken = PooledBlock;
+			PooledBlock = FBlock();
+		}
+	}
+
+	if (!Taken.Data)
+	{
+		Taken = AllocateBlock(LayoutSize, bUseHugePages);
+	}
+
+	Block = Taken.Data;
+	BlockSize = Taken.Size;
+	bBlockHugePages = Taken.bHugePages;
+
+	// A reused block still holds the last world's state
+	FMemory::Memzero(Block, LayoutSize);
+}
+
+void FFluidArena::Release()
+{
+	if (Block)
+	{
+#if !UE_BUILD_SHIPPING
+		// Views into the planes must not outlive the owner; poison the block so a stale reader shows up
+		// as garbage right away instead of silently tracking the next world's grid
+		FMemory::Memset(Block, 0xDD, LayoutSize);
+#endif
+
+		FBlock Returned;
+		Returned.Data = Block;
+		Returned.Size = BlockSize;
+		Returned.bHugePages = bBlockHugePages;
+
+		{
+			FScopeLock Lock(&PoolLock);
+			if (!PooledBlock.Data || PooledBlock.Size < Returned.Size)
+			{
+				Swap(PooledBlock, Returned);
+			}
+		}
+
+		// Whichever block lost the pool slot goes back to the OS
+		if (Returned.Data)
+		{
+			FreeBlock(Returned);
+		}
+	}
+
+	Block = nullptr;
+	BlockSize = 0;
+	bBlockHugePages = false;
+	LayoutSize = 0;
+}
+
+FFluidArena::FBlock FFluidArena::AllocateBlock(SIZE_T Size, bool bUseHugePages)
+{
+	FBlock Result;
+	Result.Size = Size;
+
+#if PLATFORM_LINUX
+	if (bUseHugePages)
+	{
+		// Explicit huge pages first; fall back to transparent ones if none are reserved
+		const SIZE_T MappedSize = Align(Size, HugePageSize);
+		void* Mapped = mmap(nullptr, MappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (Mapped == MAP_FAILED)
+		{
+			Mapped = mmap(nullptr, MappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (Mapped != MAP_FAILED)
+			{
+				madvise(Mapped, MappedSize, MADV_HUGEPAGE);
+			}
+		}
+
+		if (Mapped != MAP_FAILED)
+		{
+			Result.Data = static_cast<uint8*>(Mapped);
+			Result.Size = MappedSize;
+			Result.bHugePages = true;
+			return Result;
+		}
+
+		UE_LOG(LogTemp, Warning, TEXT("FluidArena: huge page mapping of %llu bytes failed, using the default allocator"),
+			static_cast<uint64>(MappedSize));
+	}
+#endif
+
+	Result.Data = static_cast<uint8*>(FMemory::Malloc(Size, Alignment));
+	return Result;
+}
+
+void FFluidArena::FreeBlock(const FBlock& Block)
+{
+#if PLATFORM_LINUX
+	if (Block.bHugePages)
+	{
+		munmap(Block.Data, Block.Size);
+		return;
+	}
+#endif
+
+	FMemory::Free(Block.Data);
+}
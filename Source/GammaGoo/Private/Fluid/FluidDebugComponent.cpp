@@ -0,0 +1,150 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidDebugComponent.h"
+#include "Engine/Engine.h"
+#include "Materials/Material.h"
+#include "PrimitiveSceneProxy.h"
+#include "DynamicMeshBuilder.h"
+#include "SceneManagement.h"
+#include "RenderingThread.h"
+
+// ---------------------------------------------------------------------------
+// Scene Proxy
+// ---------------------------------------------------------------------------
+
+/**
+ * Holds the expanded debug mesh on the render thread. The whole grid is submitted
+ * as one mesh batch per view, so draw cost no longer scales with DrawDebugBox calls.
+ */
+class FFluidDebugSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	explicit FFluidDebugSceneProxy(const UFluidDebugComponent* InComponent)
+		: FPrimitiveSceneProxy(InComponent)
+		, MaterialProxy(GEngine->VertexColorMaterial->GetRenderProxy())
+	{
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	void SetQuads_RenderThread(TArray<FFluidDebugQuad>&& Quads)
+	{
+		check(IsInRenderingThread());
+
+		Vertices.Reset(Quads.Num() * 4);
+		Indices.Reset(Quads.Num() * 6);
+
+		const FVector3f TangentX(1.f, 0.f, 0.f);
+		const FVector3f TangentZ(0.f, 0.f, 1.f);
+
+		for (const FFluidDebugQuad& Quad : Quads)
+		{
+			const uint32 Base = Vertices.Num();
+			const float E = Quad.HalfExtent;
+
+			Vertices.Emplace(Quad.Center + FVector3f(-E, -E, 0.f), TangentX, TangentZ, FVector2f(0.f, 0.f), Quad.Color);
+			Vertices.Emplace(Quad.Center + FVector3f( E, -E, 0.f), TangentX, TangentZ, FVector2f(1.f, 0.f), Quad.Color);
+			Vertices.Emplace(Quad.Center + FVector3f( E,  E, 0.f), TangentX, TangentZ, FVector2f(1.f, 1.f), Quad.Color);
+			Vertices.Emplace(Quad.Center + FVector3f(-E,  E, 0.f), TangentX, TangentZ, FVector2f(0.f, 1.f), Quad.Color);
+
+			Indices.Append({ Base, Base + 2, Base + 1, Base, Base + 3, Base + 2 });
+		}
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily,
+		uint32 VisibilityMap, FMeshElementCollector& Collector) const override
+	{
+		if (Indices.Num() == 0 || !MaterialProxy) { return; }
+
+		for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+		{
+			if (!(VisibilityMap & (1 << ViewIndex))) { continue; }
+
+			FDynamicMeshBuilder MeshBuilder(Views[ViewIndex]->GetFeatureLevel());
+			MeshBuilder.AddVertices(Vertices);
+			MeshBuilder.AddTriangles(Indices);
+			MeshBuilder.GetMesh(FMatrix::Identity, MaterialProxy, SDPG_World,
+				/*bDisableBackfaceCulling=*/true, /*bReceivesDecals=*/false, ViewIndex, Collector);
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View);
+		Result.bDynamicRelevance = true;
+		Result.bShadowRelevance = false;
+		Result.bRenderInMainPass = ShouldRenderInMainPass();
+		Result.bEditorPrimitiveRelevance = UseEditorCompositing(View);
+		return Result;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize() + Vertices.GetAllocatedSize() + Indices.GetAllocatedSize();
+	}
+
+private:
+	const FMaterialRenderProxy* MaterialProxy = nullptr;
+	TArray<FDynamicMeshVertex> Vertices;
+	TArray<uint32> Indices;
+};
+
+// ---------------------------------------------------------------------------
+// Component
+// ---------------------------------------------------------------------------
+
+UFluidDebugComponent::UFluidDebugComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetCastShadow(false);
+	SetGenerateOverlapEvents(false);
+	bUseEditorCompositing = true;
+	bIsEditorOnly = false;
+}
+
+void UFluidDebugComponent::SetQuads(TArray<FFluidDebugQuad>&& Quads)
+{
+	FFluidDebugSceneProxy* Proxy = static_cast<FFluidDebugSceneProxy*>(SceneProxy);
+	if (!Proxy) { return; }
+
+	ENQUEUE_RENDER_COMMAND(UpdateFluidDebugMesh)(
+		[Proxy, Data = MoveTemp(Quads)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			Proxy->SetQuads_RenderThread(MoveTemp(Data));
+		}
+	);
+}
+
+void UFluidDebugComponent::SetDrawBounds(const FBox& InBounds)
+{
+	DrawBounds = InBounds;
+	UpdateBounds();
+	MarkRenderTransformDirty();
+}
+
+FPrimitiveSceneProxy* UFluidDebugComponent::CreateSceneProxy()
+{
+	if (!GEngine || !GEngine->VertexColorMaterial) { return nullptr; }
+	return new FFluidDebugSceneProxy(this);
+}
+
+FBoxSphereBounds UFluidDebugComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	// Quads are built in world space, so the bounds ignore the component transform.
+	return DrawBounds.IsValid ? FBoxSphereBounds(DrawBounds) : FBoxSphereBounds(ForceInit);
+}
+
+void UFluidDebugComponent::GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials) const
+{
+	if (GEngine && GEngine->VertexColorMaterial)
+	{
+		OutMaterials.Add(GEngine->VertexColorMaterial);
+	}
+}
@@ -0,0 +1,251 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidForecastSubsystem.h"
+#include "Fluid/FluidKernel.h"
+#include "Fluid/FluidSubsystem.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "TextureResource.h"
+#include "TimerManager.h"
+
+namespace
+{
+	constexpr int32 TexelsPerSide = FluidConstants::GridSize / FluidConstants::ForecastCellsPerTexel;
+}
+
+void UFluidForecastSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	FluidSubsystem = Collection.InitializeDependency<UFluidSubsystem>();
+}
+
+void UFluidForecastSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PollHandle);
+	}
+
+	if (PendingJob)
+	{
+		PendingJob->bCancelled = true;
+		PendingTask.Wait();
+		PendingJob.Reset();
+	}
+
+	Snapshot.Reset();
+	FluidSubsystem = nullptr;
+	DeltaTexture = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UFluidForecastSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(
+		PollHandle,
+		FTimerDelegate::CreateUObject(this, &UFluidForecastSubsystem::PollForecast),
+		PollInterval,
+		/*bLoop=*/true
+	);
+}
+
+// ---------------------------------------------------------------------------
+// Requests
+// ---------------------------------------------------------------------------
+
+void UFluidForecastSubsystem::RequestForecast(const FFluidForecastEdit& Edit)
+{
+	if (!FluidSubsystem || !FluidSubsystem->IsTerrainReady()) { return; }
+
+	CancelPendingJob();
+
+	// Refresh the captured state once it is old enough that the baseline no longer reflects the grid
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (!Snapshot || Now - SnapshotTime > SnapshotMaxAge)
+	{
+		TSharedPtr<FFluidSimState, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FFluidSimState, ESPMode::ThreadSafe>();
+		FluidSubsystem->CaptureSimState(*NewSnapshot);
+		Snapshot = NewSnapshot;
+		SnapshotTime = Now;
+		BaselineDepths.Reset();
+	}
+
+	TSharedPtr<FForecastJob, ESPMode::ThreadSafe> Job = MakeShared<FForecastJob, ESPMode::ThreadSafe>();
+	Job->Snapshot = Snapshot;
+	Job->Edit = Edit;
+	Job->NumSteps = FMath::CeilToInt(ForecastHorizon / Snapshot->StepSeconds);
+	Job->bNeedsBaseline = BaselineDepths.Num() == 0;
+
+	PendingJob = Job;
+	PendingTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]() { RunForecastJob(*Job); });
+}
+
+void UFluidForecastSubsystem::ClearForecast()
+{
+	CancelPendingJob();
+	DepthDeltas.Reset();
+}
+
+void UFluidForecastSubsystem::CancelPendingJob()
+{
+	// The job owns its inputs, so it can be abandoned without waiting for the worker
+	if (PendingJob)
+	{
+		PendingJob->bCancelled = true;
+		PendingJob.Reset();
+	}
+}
+
+void UFluidForecastSubsystem::PollForecast()
+{
+	if (!PendingJob || !PendingTask.IsCompleted()) { return; }
+
+	TSharedPtr<FForecastJob, ESPMode::ThreadSafe> Job = MoveTemp(PendingJob);
+	if (!Job->bCancelled)
+	{
+		ApplyJob(*Job);
+	}
+}
+
+void UFluidForecastSubsystem::ApplyJob(FForecastJob& Job)
+{
+	if (Job.bNeedsBaseline && Job.Snapshot == Snapshot)
+	{
+		BaselineDepths = Job.BaselineDepths;
+	}
+	const TArray<float>& Baseline = Job.bNeedsBaseline ? Job.BaselineDepths : BaselineDepths;
+	if (Baseline.Num() != Job.EditedDepths.Num()) { return; }
+
+	DepthDeltas.SetNumUninitialized(Baseline.Num());
+	for (int32 I = 0; I < Baseline.Num(); ++I)
+	{
+		DepthDeltas[I] = Job.EditedDepths[I] - Baseline[I];
+	}
+
+	UpdateDeltaTexture();
+	OnForecastReady.Broadcast();
+}
+
+float UFluidForecastSubsystem::GetForecastDepthDeltaAtWorldPos(FVector WorldPos) const
+{
+	if (!FluidSubsystem || DepthDeltas.Num() == 0) { return 0.f; }
+
+	const FIntPoint Cell = FluidSubsystem->WorldToCell(WorldPos);
+	if (!FluidSubsystem->IsValidCell(Cell.X, Cell.Y)) { return 0.f; }
+
+	const int32 TX = Cell.X / FluidConstants::ForecastCellsPerTexel;
+	const int32 TY = Cell.Y / FluidConstants::ForecastCellsPerTexel;
+	return DepthDeltas[TY * TexelsPerSide + TX];
+}
+
+// ---------------------------------------------------------------------------
+// Worker
+// ---------------------------------------------------------------------------
+
+void UFluidForecastSubsystem::RunForecastJob(FForecastJob& Job)
+{
+	// Both runs start from the same awake set, or tiles asleep in the capture would move only in the
+	// edited run and show up as deltas far from the edit
+	if (Job.bNeedsBaseline)
+	{
+		FFluidSimState Baseline = *Job.Snapshot;
+		Baseline.AwakeTiles.SetRange(0, FluidConstants::TotalTiles, true);
+		if (!RunHeadless(Baseline, nullptr, Job.NumSteps, Job.bCancelled)) { return; }
+		CoarsenDepths(Baseline, Job.BaselineDepths);
+	}
+
+	FFluidSimState Edited = *Job.Snapshot;
+	for (const int32 Idx : Job.Edit.BlockedCells)
+	{
+		FluidKernel::SetBlocked(Edited.Grid, Edited.NeighborMasks,
+			FluidGrid::CellX(Idx), FluidGrid::CellY(Idx), true);
+	}
+	for (const int32 Idx : Job.Edit.FrozenCells)
+	{
+		Edited.Grid[Idx].bFrozen = true;
+	}
+	Edited.AwakeTiles.SetRange(0, FluidConstants::TotalTiles, true);
+
+	if (!RunHeadless(Edited, &Job.Edit, Job.NumSteps, Job.bCancelled)) { return; }
+	CoarsenDepths(Edited, Job.EditedDepths);
+}
+
+bool UFluidForecastSubsystem::RunHeadless(FFluidSimState& State, const FFluidForecastEdit* Edit, int32 NumSteps, const std::atomic<bool>& bCancelled)
+{
+	const float StepRemoval = Edit ? Edit->RemovalPerSecond * State.StepSeconds : 0.f;
+
+	for (int32 Step = 0; Step < NumSteps; ++Step)
+	{
+		if (bCancelled) { return false; }
+
+		if (StepRemoval > 0.f)
+		{
+			float TotalVolume = 0.f;
+			for (const int32 Idx : Edit->RemovalCells)
+			{
+				TotalVolume += State.Grid[Idx].FluidVolume;
+			}
+
+			if (TotalVolume > 0.f)
+			{
+				const float Keep = 1.f - FMath::Min(StepRemoval / TotalVolume, 1.f);
+				for (const int32 Idx : Edit->RemovalCells)
+				{
+					State.Grid[Idx].FluidVolume *= Keep;
+					State.AwakeTiles[FluidGrid::TileOfCell(Idx)] = true;
+				}
+			}
+		}
+
+		State.Step();
+	}
+
+	return !bCancelled;
+}
+
+void UFluidForecastSubsystem::CoarsenDepths(const FFluidSimState& State, TArray<float>& OutDepths)
+{
+	const int32 CellsPerTexel = FluidConstants::ForecastCellsPerTexel;
+	const float InvCount = 1.f / (CellsPerTexel * CellsPerTexel);
+
+	OutDepths.Init(0.f, TexelsPerSide * TexelsPerSide);
+	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+	{
+		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		{
+			OutDepths[(Y / CellsPerTexel) * TexelsPerSide + X / CellsPerTexel] +=
+				State.Grid[FluidGrid::CellIndex(X, Y)].FluidVolume * InvCount;
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Delta texture
+// ---------------------------------------------------------------------------
+
+void UFluidForecastSubsystem::UpdateDeltaTexture()
+{
+	if (!DeltaTexture)
+	{
+		DeltaTexture = UTexture2D::CreateTransient(TexelsPerSide, TexelsPerSide, PF_R32_FLOAT, TEXT("FluidForecastDelta"));
+		if (!DeltaTexture) { return; }
+		DeltaTexture->Filter = TF_Bilinear;
+		DeltaTexture->SRGB = false;
+		DeltaTexture->UpdateResource();
+	}
+
+	const int32 NumBytes = DepthDeltas.Num() * sizeof(float);
+	uint8* Pixels = new uint8[NumBytes];
+	FMemory::Memcpy(Pixels, DepthDeltas.GetData(), NumBytes);
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, TexelsPerSide, TexelsPerSide);
+	DeltaTexture->UpdateTextureRegions(0, 1, Region, TexelsPerSide * sizeof(float), sizeof(float), Pixels,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] SrcData;
+			delete Regions;
+		});
+}
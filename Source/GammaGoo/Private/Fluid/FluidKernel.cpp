@@ -0,0 +1,478 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidKernel.h"
+
+namespace
+{
+	// Direction vectors for velocity computation (matches NeighborDX/DY order)
+	const FVector2D DirVec[4] = {
+		FVector2D(1.f, 0.f),   // +X (East)
+		FVector2D(-1.f, 0.f),  // -X (West)
+		FVector2D(0.f, 1.f),   // +Y (North)
+		FVector2D(0.f, -1.f)   // -Y (South)
+	};
+
+	/**
+	 * Pass 1 for one tile. Each check a tile cannot need is compiled out: bCheckFrozen (frozen, or held
+	 * by a lake) / bCheckBlocked skip source cells, bUseMasks reads NeighborMasks (grid edge, or a
+	 * blocked or held cell in or next to the tile). With all three false every neighbour is open and
+	 * only dryness is tested.
+	 */
+	template <bool bCheckFrozen, bool bCheckBlocked, bool bUseMasks>
+	void AccumulateTile(const FFluidStepParams& Params, FFluidStepContext& Ctx, int32 X0, int32 Y0, bool bRecordStepCost)
+	{
+		using namespace FluidConstants;
+		static_assert(!bCheckBlocked || bUseMasks, "Blocked cells close their neighbours' mask bits");
+
+		const TArrayView<FFluidCell> Grid = Ctx.Grid;
+
+		for (int32 Y = Y0; Y < Y0 + TileSize; ++Y)
+		{
+			for (int32 X = X0; X < X0 + TileSize; ++X)
+			{
+				const int32 Idx = FluidGrid::CellIndex(X, Y);
+				const FFluidCell& Cell = Grid[Idx];
+
+				if constexpr (bCheckFrozen) { if (Cell.bFrozen || (Ctx.HeldCells && (*Ctx.HeldCells)[Idx])) { continue; } }
+				if constexpr (bCheckBlocked) { if (Cell.bBlocked) { continue; } }
+				if (Cell.FluidVolume <= KINDA_SMALL_NUMBER) { continue; }
+
+				const float CellSurface = Cell.GetSurfaceHeight();
+				const float CurrentVolume = Cell.FluidVolume;
+
+				// Bit per direction: neighbour is in bounds and not blocked. Maintained by SetBlocked.
+				[[maybe_unused]] const uint8 OpenMask = bUseMasks ? Ctx.NeighborMasks[Idx] : AllNeighborsOpen;
+
+				float TotalOutflow = 0.f;
+				float NeighborTransfer[4] = {};
+				uint8 StepCost = 1;
+
+				for (int32 Dir = 0; Dir < 4; ++Dir)
+				{
+					if constexpr (bUseMasks) { if (!(OpenMask & (1 << Dir))) { continue; } }
+
+					const FFluidCell& Neighbor = Grid[FluidGrid::CellIndex(X + NeighborDX[Dir], Y + NeighborDY[Dir])];
+					++StepCost;
+
+					const float Delta = CellSurface - Neighbor.GetSurfaceHeight();
+					if (Delta <= 0.f) { continue; }
+
+					float Transfer = Delta * Params.FlowRate;
+					Transfer = FMath::Min(Transfer, Delta * Params.OscillationClamp);
+
+					NeighborTransfer[Dir] = Transfer;
+					TotalOutflow += Transfer;
+				}
+
+				// Scale back if total outflow exceeds available volume
+				if (TotalOutflow > CurrentVolume && TotalOutflow > KINDA_SMALL_NUMBER)
+				{
+					const float Scale = CurrentVolume / TotalOutflow;
+					for (int32 Dir = 0; Dir < 4; ++Dir)
+					{
+						NeighborTransfer[Dir] *= Scale;
+					}
+					TotalOutflow = CurrentVolume;
+				}
+
+				if (bRecordStepCost)
+				{
+					Ctx.StepCost[Idx] = StepCost;
+				}
+
+				// Accumulate
+				Ctx.FluidDeltas[Idx] -= TotalOutflow;
+
+				for (int32 Dir = 0; Dir < 4; ++Dir)
+				{
+					if (NeighborTransfer[Dir] <= 0.f) { continue; }
+					Ctx.FluidDeltas[FluidGrid::CellIndex(X + NeighborDX[Dir], Y + NeighborDY[Dir])] += NeighborTransfer[Dir];
+					Ctx.FlowVelocityDeltas[Idx] += DirVec[Dir] * NeighborTransfer[Dir];
+				}
+			}
+		}
+	}
+
+	using FAccumulateTileFn = void (*)(const FFluidStepParams&, FFluidStepContext&, int32, int32, bool);
+
+	// Indexed by bCheckFrozen | bCheckBlocked << 1 | bUseMasks << 2. Blocked without masks cannot occur.
+	const FAccumulateTileFn AccumulateTileVariants[8] = {
+		&AccumulateTile<false, false, false>,
+		&AccumulateTile<true,  false, false>,
+		&AccumulateTile<false, true,  true>,
+		&AccumulateTile<true,  true,  true>,
+		&AccumulateTile<false, false, true>,
+		&AccumulateTile<true,  false, true>,
+		&AccumulateTile<false, true,  true>,
+		&AccumulateTile<true,  true,  true>,
+	};
+	constexpr uint32 GeneralTileVariant = 7;
+}
+
+namespace FluidKernel
+{
+
+void StepFlow(const FFluidStepParams& Params, FFluidStepContext& Ctx)
+{
+	using namespace FluidConstants;
+
+	const int32* DX = NeighborDX;
+	const int32* DY = NeighborDY;
+
+	TArrayView<FFluidCell> Grid = Ctx.Grid;
+	TBitArray<>& AwakeTiles = *Ctx.AwakeTiles;
+	TBitArray<>& StepTiles = *Ctx.StepTiles;
+	const bool bRecordStepCost = Ctx.StepCost.Num() > 0;
+	const bool bHasTileCounts = Ctx.TileFrozenCounts.Num() > 0 && Ctx.TileBlockedCounts.Num() > 0;
+	const bool bHasHeldCounts = Ctx.TileHeldCounts.Num() > 0;
+	constexpr uint16 TileCells = TileSize * TileSize;
+
+	// A held cell only borders cells of its own lake, whose open bits toward it are closed
+	auto HasHeld = [&](int32 Tile) { return bHasHeldCounts && Ctx.TileHeldCounts[Tile] > 0; };
+	auto IsAllHeld = [&](int32 Tile) { return bHasHeldCounts && Ctx.TileHeldCounts[Tile] == TileCells; };
+
+	// Transfers out of an awake tile can land in its cardinal neighbour tiles, so those
+	// take part in pass 2 this step even if they are asleep.
+	StepTiles.SetRange(0, TotalTiles, false);
+	for (TConstSetBitIterator<> It(AwakeTiles); It; ++It)
+	{
+		const int32 TX = It.GetIndex() % TilesPerSide;
+		const int32 TY = It.GetIndex() / TilesPerSide;
+		StepTiles[It.GetIndex()] = true;
+		for (int32 Dir = 0; Dir < 4; ++Dir)
+		{
+			const int32 NTX = TX + DX[Dir];
+			const int32 NTY = TY + DY[Dir];
+			if (NTX < 0 || NTX >= TilesPerSide || NTY < 0 || NTY >= TilesPerSide) { continue; }
+			StepTiles[NTY * TilesPerSide + NTX] = true;
+		}
+	}
+
+	// --- Pass 1: Compute transfers for awake tiles, accumulate deltas ---
+	// Each tile runs the cheapest variant its contents allow; without counts every tile takes the general one.
+	for (TConstSetBitIterator<> TileIt(AwakeTiles); TileIt; ++TileIt)
+	{
+		const int32 Tile = TileIt.GetIndex();
+		if (IsAllHeld(Tile)) { continue; }
+		const int32 TX = Tile % TilesPerSide;
+		const int32 TY = Tile / TilesPerSide;
+
+		uint32 Variant = GeneralTileVariant;
+		if (bHasTileCounts)
+		{
+			bool bUseMasks = TX == 0 || TY == 0 || TX == TilesPerSide - 1 || TY == TilesPerSide - 1
+				|| Ctx.TileBlockedCounts[Tile] > 0 || HasHeld(Tile);
+			for (int32 Dir = 0; Dir < 4 && !bUseMasks; ++Dir)
+			{
+				const int32 NTile = (TY + DY[Dir]) * TilesPerSide + TX + DX[Dir];
+				bUseMasks = Ctx.TileBlockedCounts[NTile] > 0 || HasHeld(NTile);
+			}
+
+			Variant = (Ctx.TileFrozenCounts[Tile] > 0 || HasHeld(Tile) ? 1 : 0)
+				| (Ctx.TileBlockedCounts[Tile] > 0 ? 2 : 0)
+				| (bUseMasks ? 4 : 0);
+		}
+
+		AccumulateTileVariants[Variant](Params, Ctx, TX * TileSize, TY * TileSize, bRecordStepCost);
+	}
+
+	// --- Pass 2: Apply deltas tile by tile. Wet and awake masks fall out of the same sweep ---
+	// Accumulators are cleared as they are consumed, so untouched tiles never need zeroing.
+	AwakeTiles.SetRange(0, TotalTiles, false);
+	const float SleepSpeedSq = FMath::Square(TileSleepSpeedEpsilon);
+
+	for (TConstSetBitIterator<> TileIt(StepTiles); TileIt; ++TileIt)
+	{
+		// Nothing moves in or out of a held cell, so its accumulators are already zero
+		const int32 Tile = TileIt.GetIndex();
+		if (IsAllHeld(Tile)) { continue; }
+		const int32 TX = Tile % TilesPerSide;
+		const int32 TY = Tile / TilesPerSide;
+		const int32 X0 = TX * TileSize;
+		const int32 Y0 = TY * TileSize;
+		bool bTileWet = false;
+		bool bTileChanged = false;
+		float TileVolume = 0.f;
+
+		for (int32 Y = Y0; Y < Y0 + TileSize; ++Y)
+		{
+			for (int32 X = X0; X < X0 + TileSize; ++X)
+			{
+				const int32 I = FluidGrid::CellIndex(X, Y);
+				FFluidCell& Cell = Grid[I];
+				Cell.FluidVolume = FMath::Max(0.f, Cell.FluidVolume + Ctx.FluidDeltas[I]);
+				// Derive FlowVelocity: damp existing + add new outflow direction
+				Cell.FlowVelocity = Cell.FlowVelocity * Params.VelocityDamping + Ctx.FlowVelocityDeltas[I];
+				bTileWet |= Cell.FluidVolume > KINDA_SMALL_NUMBER;
+				TileVolume += Cell.FluidVolume;
+				bTileChanged |= FMath::Abs(Ctx.FluidDeltas[I]) > TileSleepVolumeEpsilon
+					|| Cell.FlowVelocity.SizeSquared() > SleepSpeedSq;
+
+				Ctx.FluidDeltas[I] = 0.f;
+				Ctx.FlowVelocityDeltas[I] = FVector2D::ZeroVector;
+			}
+		}
+
+		if (Ctx.WetTileMask)
+		{
+			(*Ctx.WetTileMask)[Tile] = bTileWet;
+		}
+		if (Ctx.TileVolumes.Num() > 0)
+		{
+			Ctx.TileVolumes[Tile] = TileVolume;
+		}
+
+		if (bTileChanged)
+		{
+			// Neighbours' edge cells now see a different surface, so they run next step too
+			AwakeTiles[Tile] = true;
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				const int32 NTX = TX + DX[Dir];
+				const int32 NTY = TY + DY[Dir];
+				if (NTX < 0 || NTX >= TilesPerSide || NTY < 0 || NTY >= TilesPerSide) { continue; }
+				AwakeTiles[NTY * TilesPerSide + NTX] = true;
+			}
+		}
+	}
+}
+
+void RelaxPools(const FFluidPoolParams& Params, FFluidStepContext& Ctx)
+{
+	using namespace FluidConstants;
+
+	TArrayView<FFluidCell> Grid = Ctx.Grid;
+	TArray<float> BlockVolume;
+	TArray<float> BlockSurface;
+	TArray<FVector2f> BlockSurfaceRange;
+	TArray<float> BlockOutflow;
+	TArray<float> BlockDelta;
+
+	// Flow from block to its East / North neighbour this pass; negative runs the other way
+	TArray<FVector2f> EdgeFlow;
+
+	// Coarsest first: it moves the bulk, the finer levels then even out what is left between blocks
+	for (int32 Level = FMath::Min(Params.NumLevels, FMath::FloorLog2(GridSize) - 1); Level >= 1; --Level)
+	{
+		const int32 BlockSize = 1 << (Level + 1);
+		const int32 BlocksPerSide = GridSize / BlockSize;
+		const int32 NumBlocks = BlocksPerSide * BlocksPerSide;
+		const int32 CellsPerBlock = BlockSize * BlockSize;
+
+		// --- Mean surface per block. Volume < 0 marks a block that is not fully submerged ---
+		BlockVolume.SetNumUninitialized(NumBlocks);
+		BlockSurface.SetNumUninitialized(NumBlocks);
+		BlockSurfaceRange.SetNumUninitialized(NumBlocks);
+		int32 NumPoolBlocks = 0;
+		const double MaxSpeedSq = FMath::Square(static_cast<double>(Params.MaxSpeed));
+
+		for (int32 Block = 0; Block < NumBlocks; ++Block)
+		{
+			const int32 X0 = (Block % BlocksPerSide) * BlockSize;
+			const int32 Y0 = (Block / BlocksPerSide) * BlockSize;
+			float Volume = 0.f;
+			float SurfaceSum = 0.f;
+			float MinSurface = TNumericLimits<float>::Max();
+			float MaxSurface = TNumericLimits<float>::Lowest();
+			bool bPool = true;
+
+			for (int32 Y = Y0; Y < Y0 + BlockSize && bPool; ++Y)
+			{
+				for (int32 X = X0; X < X0 + BlockSize; ++X)
+				{
+					const int32 Idx = FluidGrid::CellIndex(X, Y);
+					const FFluidCell& Cell = Grid[Idx];
+					if (Cell.bFrozen || Cell.bBlocked || Cell.FluidVolume < Params.MinDepth) { bPool = false; break; }
+					if (Ctx.HeldCells && (*Ctx.HeldCells)[Idx]) { bPool = false; break; }
+					if (Cell.FlowVelocity.SizeSquared() > MaxSpeedSq) { bPool = false; break; }
+
+					const float Surface = Cell.GetSurfaceHeight();
+					MinSurface = FMath::Min(MinSurface, Surface);
+					MaxSurface = FMath::Max(MaxSurface, Surface);
+					Volume += Cell.FluidVolume;
+					SurfaceSum += Surface;
+				}
+			}
+
+			// A sloped sheet is deep and submerged too; only a flat one is a pool
+			bPool &= MaxSurface - MinSurface <= Params.MaxSurfaceRange;
+
+			BlockVolume[Block] = bPool ? Volume : -1.f;
+			BlockSurface[Block] = SurfaceSum / CellsPerBlock;
+			BlockSurfaceRange[Block] = FVector2f(MinSurface, MaxSurface);
+			NumPoolBlocks += bPool ? 1 : 0;
+		}
+
+		if (NumPoolBlocks < 2) { continue; }
+
+		// --- Transfers across shared edges. Closing the whole gap between two equal blocks takes N/2 ---
+		EdgeFlow.Init(FVector2f::ZeroVector, NumBlocks);
+		BlockOutflow.Init(0.f, NumBlocks);
+		const float EdgeGain = Params.Relaxation * CellsPerBlock * 0.5f;
+
+		// Two flat blocks at different levels (a terrace, a spill step) are separate bodies
+		auto CanExchange = [&](int32 A, int32 B)
+		{
+			if (BlockVolume[B] < 0.f) { return false; }
+			const float Lo = FMath::Min(BlockSurfaceRange[A].X, BlockSurfaceRange[B].X);
+			const float Hi = FMath::Max(BlockSurfaceRange[A].Y, BlockSurfaceRange[B].Y);
+			return Hi - Lo <= Params.MaxSurfaceRange;
+		};
+
+		for (int32 Block = 0; Block < NumBlocks; ++Block)
+		{
+			if (BlockVolume[Block] < 0.f) { continue; }
+			const int32 BX = Block % BlocksPerSide;
+			const int32 BY = Block / BlocksPerSide;
+
+			if (BX + 1 < BlocksPerSide && CanExchange(Block, Block + 1))
+			{
+				const float Q = (BlockSurface[Block] - BlockSurface[Block + 1]) * EdgeGain;
+				EdgeFlow[Block].X = Q;
+				BlockOutflow[Q > 0.f ? Block : Block + 1] += FMath::Abs(Q);
+			}
+			if (BY + 1 < BlocksPerSide && CanExchange(Block, Block + BlocksPerSide))
+			{
+				const float Q = (BlockSurface[Block] - BlockSurface[Block + BlocksPerSide]) * EdgeGain;
+				EdgeFlow[Block].Y = Q;
+				BlockOutflow[Q > 0.f ? Block : Block + BlocksPerSide] += FMath::Abs(Q);
+			}
+		}
+
+		// A block gives away at most half its volume per pass; its outgoing edges share the cut
+		auto SourceScale = [&](int32 Block)
+		{
+			const float Limit = BlockVolume[Block] * 0.5f;
+			return BlockOutflow[Block] > Limit ? Limit / BlockOutflow[Block] : 1.f;
+		};
+
+		BlockDelta.Init(0.f, NumBlocks);
+		for (int32 Block = 0; Block < NumBlocks; ++Block)
+		{
+			const int32 Neighbors[2] = { Block + 1, Block + BlocksPerSide };
+			const float Flows[2] = { EdgeFlow[Block].X, EdgeFlow[Block].Y };
+			for (int32 Axis = 0; Axis < 2; ++Axis)
+			{
+				if (Flows[Axis] == 0.f) { continue; }
+				const float Q = Flows[Axis] * SourceScale(Flows[Axis] > 0.f ? Block : Neighbors[Axis]);
+				BlockDelta[Block] -= Q;
+				BlockDelta[Neighbors[Axis]] += Q;
+			}
+		}
+
+		// --- Apply. Gains spread evenly, which raises the block's surface flat; losses are taken in
+		// proportion to depth so no cell can go negative. Either way the block total moves by exactly Delta.
+		for (int32 Block = 0; Block < NumBlocks; ++Block)
+		{
+			const float Delta = BlockDelta[Block];
+			if (Delta == 0.f) { continue; }
+
+			const int32 X0 = (Block % BlocksPerSide) * BlockSize;
+			const int32 Y0 = (Block / BlocksPerSide) * BlockSize;
+			const float Gain = Delta > 0.f ? Delta / CellsPerBlock : 0.f;
+			const float LossFraction = Delta < 0.f ? -Delta / BlockVolume[Block] : 0.f;
+			bool bWake = false;
+
+			for (int32 Y = Y0; Y < Y0 + BlockSize; ++Y)
+			{
+				for (int32 X = X0; X < X0 + BlockSize; ++X)
+				{
+					FFluidCell& Cell = Grid[FluidGrid::CellIndex(X, Y)];
+					const float Change = Gain - Cell.FluidVolume * LossFraction;
+					Cell.FluidVolume += Change;
+					bWake |= FMath::Abs(Change) > TileSleepVolumeEpsilon;
+
+					if (Ctx.TileVolumes.Num() > 0)
+					{
+						Ctx.TileVolumes[FluidGrid::TileOfCell(FluidGrid::CellIndex(X, Y))] += Change;
+					}
+				}
+			}
+
+			if (!bWake) { continue; }
+
+			// The block's rim now sees a different surface, so the ring of tiles around it wakes too
+			const int32 MinTX = FMath::Max(X0 - 1, 0) / TileSize;
+			const int32 MinTY = FMath::Max(Y0 - 1, 0) / TileSize;
+			const int32 MaxTX = FMath::Min(X0 + BlockSize, GridSize - 1) / TileSize;
+			const int32 MaxTY = FMath::Min(Y0 + BlockSize, GridSize - 1) / TileSize;
+			for (int32 TY = MinTY; TY <= MaxTY; ++TY)
+			{
+				(*Ctx.AwakeTiles).SetRange(TY * TilesPerSide + MinTX, MaxTX - MinTX + 1, true);
+			}
+		}
+	}
+}
+
+void SetBlocked(TArrayView<FFluidCell> Grid, TArrayView<uint8> NeighborMasks, int32 X, int32 Y, bool bBlock, TArrayView<uint16> TileBlockedCounts)
+{
+	using namespace FluidConstants;
+
+	FFluidCell& Cell = Grid[FluidGrid::CellIndex(X, Y)];
+	if (TileBlockedCounts.Num() > 0 && Cell.bBlocked != bBlock)
+	{
+		uint16& Count = TileBlockedCounts[(Y / TileSize) * TilesPerSide + X / TileSize];
+		Count = bBlock ? Count + 1 : Count - 1;
+	}
+	Cell.bBlocked = bBlock;
+
+	// Keep the neighbours' open bits pointing at this cell in sync
+	for (int32 Dir = 0; Dir < 4; ++Dir)
+	{
+		const int32 NX = X + NeighborDX[Dir];
+		const int32 NY = Y + NeighborDY[Dir];
+		if (NX < 0 || NX >= GridSize || NY < 0 || NY >= GridSize) { continue; }
+
+		const uint8 TowardCell = 1 << (Dir ^ 1);
+		uint8& Mask = NeighborMasks[FluidGrid::CellIndex(NX, NY)];
+		Mask = bBlock ? (Mask & ~TowardCell) : (Mask | TowardCell);
+	}
+}
+
+void CountTileFlags(TConstArrayView<FFluidCell> Grid, TArray<uint16>& OutFrozenCounts, TArray<uint16>& OutBlockedCounts)
+{
+	OutFrozenCounts.Init(0, FluidConstants::TotalTiles);
+	OutBlockedCounts.Init(0, FluidConstants::TotalTiles);
+	for (int32 Idx = 0; Idx < Grid.Num(); ++Idx)
+	{
+		const int32 Tile = FluidGrid::TileOfCell(Idx);
+		OutFrozenCounts[Tile] += Grid[Idx].bFrozen ? 1 : 0;
+		OutBlockedCounts[Tile] += Grid[Idx].bBlocked ? 1 : 0;
+	}
+}
+
+} // namespace FluidKernel
+
+// ---------------------------------------------------------------------------
+// FFluidSimState
+// ---------------------------------------------------------------------------
+
+void FFluidSimState::Step()
+{
+	if (FluidDeltas.Num() != Grid.Num())
+	{
+		FluidDeltas.SetNumZeroed(Grid.Num());
+		FlowVelocityDeltas.SetNumZeroed(Grid.Num());
+		StepTiles.Init(false, FluidConstants::TotalTiles);
+		FluidKernel::CountTileFlags(Grid, TileFrozenCounts, TileBlockedCounts);
+	}
+
+	for (int32 I = 0; I < InflowCells.Num(); ++I)
+	{
+		const int32 Idx = InflowCells[I];
+		Grid[Idx].FluidVolume += InflowVolumes[I];
+
+		AwakeTiles[FluidGrid::TileOfCell(Idx)] = true;
+	}
+
+	FFluidStepContext Ctx;
+	Ctx.Grid = Grid;
+	Ctx.NeighborMasks = NeighborMasks;
+	Ctx.FluidDeltas = FluidDeltas;
+	Ctx.FlowVelocityDeltas = FlowVelocityDeltas;
+	Ctx.AwakeTiles = &AwakeTiles;
+	Ctx.StepTiles = &StepTiles;
+	Ctx.TileFrozenCounts = TileFrozenCounts;
+	Ctx.TileBlockedCounts = TileBlockedCounts;
+	FluidKernel::StepFlow(Params, Ctx);
+}
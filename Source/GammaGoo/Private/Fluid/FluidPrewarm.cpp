@@ -0,0 +1,27 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidPrewarm.h"
+#include "Components/SceneComponent.h"
+#include "Hash/xxhash.h"
+
+AFluidPrewarm::AFluidPrewarm()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	USceneComponent* SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+	RootComponent = SceneRoot;
+}
+
+uint64 AFluidPrewarm::ComputeDescriptionHash() const
+{
+	FXxHash64Builder Builder;
+	Builder.Update(&Duration, sizeof(Duration));
+	for (const FFluidPrewarmSource& Source : Sources)
+	{
+		const FVector WorldLocation = GetActorTransform().TransformPosition(Source.Location);
+		Builder.Update(&WorldLocation, sizeof(WorldLocation));
+		Builder.Update(&Source.Radius, sizeof(Source.Radius));
+		Builder.Update(&Source.RatePerSecond, sizeof(Source.RatePerSecond));
+	}
+	return Builder.Finalize().Hash;
+}
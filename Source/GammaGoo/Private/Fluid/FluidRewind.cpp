@@ -0,0 +1,300 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidRewind.h"
+
+namespace
+{
+	constexpr int32 TileMaskBytes = (FluidConstants::TotalTiles + 7) / 8;
+
+	/** Payload bytes per 2-bit tag. One-byte XORs are rare enough to share the two-byte tag. */
+	constexpr uint8 TagBytes[4] = { 0, 2, 3, 4 };
+
+	FORCEINLINE uint8 TagForXor(uint32 V)
+	{
+		if (V == 0) { return 0; }
+		if (V <= 0xFFFF) { return 1; }
+		if (V <= 0xFFFFFF) { return 2; }
+		return 3;
+	}
+}
+
+void FFluidRewindBuffer::FPlanes::Init()
+{
+	for (TArray<uint32>& Plane : Words)
+	{
+		Plane.SetNumZeroed(FluidConstants::TotalCells);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Recording
+// ---------------------------------------------------------------------------
+
+void FFluidRewindBuffer::Configure(int32 InMaxSteps, int32 InKeyframeInterval, SIZE_T InMaxBytes)
+{
+	InMaxSteps = FMath::Max(1, InMaxSteps);
+	InKeyframeInterval = FMath::Max(1, InKeyframeInterval);
+	if (InMaxSteps == MaxSteps && InKeyframeInterval == KeyframeInterval && InMaxBytes == MaxBytes) { return; }
+
+	MaxSteps = InMaxSteps;
+	KeyframeInterval = InKeyframeInterval;
+	MaxBytes = InMaxBytes;
+	Reset();
+}
+
+void FFluidRewindBuffer::Record(int32 Step, TConstArrayView<FFluidCell> Grid)
+{
+	check(Grid.Num() == FluidConstants::TotalCells);
+
+	if (Last.Words[0].Num() == 0)
+	{
+		Last.Init();
+		Scratch.Init();
+	}
+
+	// A gap (rewind past the history, sim restarted) breaks the delta chain
+	if (!IsEmpty() && Step != GetNewestStep() + 1)
+	{
+		Reset();
+	}
+
+	Gather(Grid, Scratch);
+
+	if (IsEmpty() || Groups.Last().FrameEnds.Num() >= KeyframeInterval)
+	{
+		FGroup& Group = Groups.AddDefaulted_GetRef();
+		Group.FirstStep = Step;
+		Group.Bytes = MoveTemp(SpareBytes);
+		Group.Bytes.Reset();
+
+		// Keyframes are deltas against an empty grid
+		for (TArray<uint32>& Plane : Last.Words)
+		{
+			FMemory::Memzero(Plane.GetData(), Plane.Num() * sizeof(uint32));
+		}
+	}
+
+	FGroup& Group = Groups.Last();
+	const int32 Start = Group.Bytes.Num();
+	Encode(Last, Scratch, Group.Bytes);
+	Group.FrameEnds.Add(Group.Bytes.Num());
+	EncodedBytes += Group.Bytes.Num() - Start;
+
+	Swap(Last, Scratch);
+	EvictOldGroups();
+}
+
+void FFluidRewindBuffer::EvictOldGroups()
+{
+	int32 TotalFrames = 0;
+	for (const FGroup& Group : Groups)
+	{
+		TotalFrames += Group.FrameEnds.Num();
+	}
+
+	// Never drop the group being written; its keyframe is the base of every delta after it
+	while (Groups.Num() > 1)
+	{
+		const FGroup& Oldest = Groups[0];
+		const bool bCoveredWithout = TotalFrames - Oldest.FrameEnds.Num() >= MaxSteps;
+		if (!bCoveredWithout && EncodedBytes <= MaxBytes) { break; }
+
+		TotalFrames -= Oldest.FrameEnds.Num();
+		EncodedBytes -= Oldest.Bytes.Num();
+		SpareBytes = MoveTemp(Groups[0].Bytes);
+		Groups.RemoveAt(0);
+	}
+}
+
+void FFluidRewindBuffer::TruncateAfter(int32 Step)
+{
+	if (IsEmpty() || Step >= GetNewestStep()) { return; }
+	if (Step < GetOldestStep())
+	{
+		Reset();
+		return;
+	}
+
+	// The next delta is taken against Step, so it becomes the base
+	DecodeStep(Step, Last);
+
+	while (Groups.Last().FirstStep > Step)
+	{
+		EncodedBytes -= Groups.Last().Bytes.Num();
+		Groups.Pop();
+	}
+
+	FGroup& Group = Groups.Last();
+	const int32 Keep = Step - Group.FirstStep + 1;
+	EncodedBytes -= Group.Bytes.Num() - Group.FrameEnds[Keep - 1];
+	Group.Bytes.SetNum(Group.FrameEnds[Keep - 1]);
+	Group.FrameEnds.SetNum(Keep);
+}
+
+void FFluidRewindBuffer::Reset()
+{
+	Groups.Reset();
+	EncodedBytes = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Playback
+// ---------------------------------------------------------------------------
+
+bool FFluidRewindBuffer::Reconstruct(int32 Step, FFluidRewindFrame& OutFrame) const
+{
+	if (IsEmpty() || Step < GetOldestStep() || Step > GetNewestStep()) { return false; }
+
+	FPlanes Planes;
+	Planes.Init();
+	DecodeStep(Step, Planes);
+
+	OutFrame.Step = Step;
+	OutFrame.FluidVolumes.SetNumUninitialized(FluidConstants::TotalCells);
+	OutFrame.FlowVelocities.SetNumUninitialized(FluidConstants::TotalCells);
+
+	int32 Packed = 0;
+	for (int32 TY = 0; TY < FluidConstants::TilesPerSide; ++TY)
+	{
+		for (int32 TX = 0; TX < FluidConstants::TilesPerSide; ++TX)
+		{
+			for (int32 LY = 0; LY < FluidConstants::TileSize; ++LY)
+			{
+				for (int32 LX = 0; LX < FluidConstants::TileSize; ++LX, ++Packed)
+				{
+					const int32 Idx = FluidGrid::CellIndex(TX * FluidConstants::TileSize + LX, TY * FluidConstants::TileSize + LY);
+					OutFrame.FluidVolumes[Idx] = FMath::AsFloat(Planes.Words[0][Packed]);
+					OutFrame.FlowVelocities[Idx] = FVector2f(FMath::AsFloat(Planes.Words[1][Packed]), FMath::AsFloat(Planes.Words[2][Packed]));
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void FFluidRewindBuffer::DecodeStep(int32 Step, FPlanes& Out) const
+{
+	int32 GroupIndex = Groups.Num() - 1;
+	while (Groups[GroupIndex].FirstStep > Step)
+	{
+		--GroupIndex;
+	}
+	const FGroup& Group = Groups[GroupIndex];
+
+	for (TArray<uint32>& Plane : Out.Words)
+	{
+		FMemory::Memzero(Plane.GetData(), Plane.Num() * sizeof(uint32));
+	}
+
+	int32 Begin = 0;
+	for (int32 Frame = 0; Frame <= Step - Group.FirstStep; ++Frame)
+	{
+		const int32 End = Group.FrameEnds[Frame];
+		Decode(TConstArrayView<uint8>(Group.Bytes.GetData() + Begin, End - Begin), Out);
+		Begin = End;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Encoding
+// ---------------------------------------------------------------------------
+
+void FFluidRewindBuffer::Gather(TConstArrayView<FFluidCell> Grid, FPlanes& Out)
+{
+	// Tile-major so a tile's cells sit together whatever the grid's own cell layout
+	int32 Packed = 0;
+	for (int32 TY = 0; TY < FluidConstants::TilesPerSide; ++TY)
+	{
+		for (int32 TX = 0; TX < FluidConstants::TilesPerSide; ++TX)
+		{
+			for (int32 LY = 0; LY < FluidConstants::TileSize; ++LY)
+			{
+				for (int32 LX = 0; LX < FluidConstants::TileSize; ++LX, ++Packed)
+				{
+					const FFluidCell& Cell = Grid[FluidGrid::CellIndex(TX * FluidConstants::TileSize + LX, TY * FluidConstants::TileSize + LY)];
+					Out.Words[0][Packed] = FMath::AsUInt(Cell.FluidVolume);
+					Out.Words[1][Packed] = FMath::AsUInt(static_cast<float>(Cell.FlowVelocity.X));
+					Out.Words[2][Packed] = FMath::AsUInt(static_cast<float>(Cell.FlowVelocity.Y));
+				}
+			}
+		}
+	}
+}
+
+void FFluidRewindBuffer::Encode(const FPlanes& Previous, const FPlanes& Current, TArray<uint8>& Out)
+{
+	const int32 MaskOffset = Out.Num();
+	Out.AddZeroed(TileMaskBytes);
+
+	for (int32 Tile = 0; Tile < FluidConstants::TotalTiles; ++Tile)
+	{
+		const int32 Base = Tile * TileCells;
+
+		uint8 PlaneMask = 0;
+		for (int32 P = 0; P < NumPlanes; ++P)
+		{
+			if (FMemory::Memcmp(&Previous.Words[P][Base], &Current.Words[P][Base], TileCells * sizeof(uint32)) != 0)
+			{
+				PlaneMask |= 1 << P;
+			}
+		}
+		if (PlaneMask == 0) { continue; }
+
+		Out[MaskOffset + Tile / 8] |= 1 << (Tile % 8);
+		Out.Add(PlaneMask);
+
+		for (int32 P = 0; P < NumPlanes; ++P)
+		{
+			if (!(PlaneMask & (1 << P))) { continue; }
+
+			// Tags for the whole tile first, four per byte, then the low bytes of each non-zero XOR
+			const int32 TagOffset = Out.Num();
+			Out.AddZeroed(TileCells / 4);
+			for (int32 C = 0; C < TileCells; ++C)
+			{
+				const uint32 Xor = Previous.Words[P][Base + C] ^ Current.Words[P][Base + C];
+				const uint8 Tag = TagForXor(Xor);
+				Out[TagOffset + C / 4] |= Tag << ((C % 4) * 2);
+				for (int32 B = 0; B < TagBytes[Tag]; ++B)
+				{
+					Out.Add(static_cast<uint8>(Xor >> (B * 8)));
+				}
+			}
+		}
+	}
+}
+
+void FFluidRewindBuffer::Decode(TConstArrayView<uint8> Bytes, FPlanes& InOut)
+{
+	const uint8* Read = Bytes.GetData();
+	const uint8* TileMask = Read;
+	Read += TileMaskBytes;
+
+	for (int32 Tile = 0; Tile < FluidConstants::TotalTiles; ++Tile)
+	{
+		if (!(TileMask[Tile / 8] & (1 << (Tile % 8)))) { continue; }
+
+		const int32 Base = Tile * TileCells;
+		const uint8 PlaneMask = *Read++;
+		for (int32 P = 0; P < NumPlanes; ++P)
+		{
+			if (!(PlaneMask & (1 << P))) { continue; }
+
+			const uint8* Tags = Read;
+			Read += TileCells / 4;
+			uint32* Words = &InOut.Words[P][Base];
+			for (int32 C = 0; C < TileCells; ++C)
+			{
+				const uint8 Tag = (Tags[C / 4] >> ((C % 4) * 2)) & 0x3;
+				uint32 V = 0;
+				for (int32 B = 0; B < TagBytes[Tag]; ++B)
+				{
+					V |= static_cast<uint32>(*Read++) << (B * 8);
+				}
+				Words[C] ^= V;
+			}
+		}
+	}
+
+	check(Read == Bytes.GetData() + Bytes.Num());
+}
@@ -2,9 +2,10 @@
 
 #include "Fluid/FluidSource.h"
 #include "Fluid/FluidSubsystem.h"
+#include "Game/FloodArrivalSubsystem.h"
 #include "Components/SceneComponent.h"
+#include "Curves/CurveFloat.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
 
 AFluidSource::AFluidSource()
 {
@@ -18,6 +19,11 @@ void AFluidSource::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (UFloodArrivalSubsystem* Arrival = GetWorld()->GetSubsystem<UFloodArrivalSubsystem>())
+	{
+		Arrival->RegisterSource(this);
+	}
+
 	FluidSubsystem = GetWorld()->GetSubsystem<UFluidSubsystem>();
 	if (!ensure(FluidSubsystem))
 	{
@@ -27,8 +33,6 @@ void AFluidSource::BeginPlay()
 		return;
 	}
 
-	CachedCellCoord = FluidSubsystem->WorldToCell(GetActorLocation());
-
 	if (bActiveOnBeginPlay)
 	{
 		Activate();
@@ -38,6 +42,12 @@ void AFluidSource::BeginPlay()
 void AFluidSource::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Deactivate();
+
+	if (UFloodArrivalSubsystem* Arrival = GetWorld()->GetSubsystem<UFloodArrivalSubsystem>())
+	{
+		Arrival->UnregisterSource(this);
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -46,25 +56,26 @@ void AFluidSource::Activate()
 	if (bActive || !FluidSubsystem) { return; }
 	bActive = true;
 
-	GetWorldTimerManager().SetTimer(
-		SpawnTimerHandle,
-		FTimerDelegate::CreateUObject(this, &AFluidSource::SpawnFluid),
-		SpawnInterval,
-		/*bLoop=*/true
-	);
+	InflowId = FluidSubsystem->RegisterInflow(GetActorLocation(), InflowRadius, GetInflowRatePerSecond(), InflowSchedule);
 }
 
 void AFluidSource::Deactivate()
 {
 	bActive = false;
-	GetWorldTimerManager().ClearTimer(SpawnTimerHandle);
+
+	if (FluidSubsystem && InflowId != INDEX_NONE)
+	{
+		FluidSubsystem->ReleaseInflow(InflowId);
+	}
+	InflowId = INDEX_NONE;
 }
 
-void AFluidSource::SpawnFluid()
+void AFluidSource::SetSpawnRate(float NewRate)
 {
-	if (!FluidSubsystem || !FluidSubsystem->IsValidCell(CachedCellCoord.X, CachedCellCoord.Y))
+	SpawnRate = NewRate;
+
+	if (FluidSubsystem && InflowId != INDEX_NONE)
 	{
-		return;
+		FluidSubsystem->SetInflowRate(InflowId, GetInflowRatePerSecond());
 	}
-	FluidSubsystem->AddFluidAtCell(CachedCellCoord.X, CachedCellCoord.Y, SpawnRate);
 }
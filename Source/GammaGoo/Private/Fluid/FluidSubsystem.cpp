@@ -1,9 +1,18 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 
 #include "Fluid/FluidSubsystem.h"
-#include "DrawDebugHelpers.h"
+#include "Fluid/FluidDebugComponent.h"
+#include "Fluid/FluidKernel.h"
+#include "Fluid/FluidPrewarm.h"
+#include "Fluid/FluidTerrainCache.h"
 #include "CollisionQueryParams.h"
+#include "Curves/CurveFloat.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
+#include "LandscapeProxy.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
+#include "Hash/xxhash.h"
+#include "Math/VectorRegister.h"
 #include "TimerManager.h"
 #include "HAL/IConsoleManager.h"
 #include "Engine/TextureRenderTarget2D.h"
@@ -19,23 +28,62 @@ void UFluidSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	const float HalfExtent = (FluidConstants::GridSize * CellWorldSize) * 0.5f;
 	GridWorldOrigin = FVector(-HalfExtent, -HalfExtent, 0.f);
 
-	Grid.SetNum(FluidConstants::TotalCells);
-	FluidDeltas.SetNum(FluidConstants::TotalCells);
-	FlowVelocityDeltas.SetNum(FluidConstants::TotalCells);
+	// Every per-cell plane comes out of one arena; the hot ones first so they share pages
+	const int32 NumCells = FluidConstants::TotalCells;
+	const TFluidArenaPlane<FFluidCell> GridPlane = Arena.AddPlane<FFluidCell>(NumCells);
+	const TFluidArenaPlane<uint8> NeighborMaskPlane = Arena.AddPlane<uint8>(NumCells);
+	const TFluidArenaPlane<float> FluidDeltaPlane = Arena.AddPlane<float>(NumCells);
+	const TFluidArenaPlane<FVector2D> FlowVelocityDeltaPlane = Arena.AddPlane<FVector2D>(NumCells);
+	const TFluidArenaPlane<float> RemovalPlaneLayout = Arena.AddPlane<float>(NumCells);
+	const TFluidArenaPlane<float> InflowPlaneLayout = Arena.AddPlane<float>(NumCells);
+	const TFluidArenaPlane<FVector2D> ForcePlaneLayout = Arena.AddPlane<FVector2D>(NumCells);
+	const TFluidArenaPlane<uint8> StepCostPlane = Arena.AddPlane<uint8>(NumCells);
+	Arena.Commit(bArenaHugePages);
+
+	Grid = Arena.ConstructPlane(GridPlane);
+	NeighborMasks = Arena.ConstructPlane(NeighborMaskPlane);
+	FluidDeltas = Arena.ConstructPlane(FluidDeltaPlane);
+	FlowVelocityDeltas = Arena.ConstructPlane(FlowVelocityDeltaPlane);
+	RemovalPlane = Arena.ConstructPlane(RemovalPlaneLayout);
+	InflowPlane = Arena.ConstructPlane(InflowPlaneLayout);
+	ForcePlane = Arena.ConstructPlane(ForcePlaneLayout);
+	CellStepCost = Arena.ConstructPlane(StepCostPlane);
+
+	WetTileMask.Init(false, FluidConstants::TotalTiles);
+	TileVolumes.SetNumZeroed(FluidConstants::TotalTiles);
+	EffectCellMask.Init(false, FluidConstants::TotalCells);
+	CellLakeIds.Init(INDEX_NONE, FluidConstants::TotalCells);
+	LakeHeldCells.Init(false, FluidConstants::TotalCells);
+	TileHeldCounts.Init(0, FluidConstants::TotalTiles);
+	CellBasinIds.Init(INDEX_NONE, FluidConstants::TotalCells);
+	AwakeTiles.Init(true, FluidConstants::TotalTiles);
+	StepTiles.Init(false, FluidConstants::TotalTiles);
+	RebuildNeighborMasks();
+	FluidKernel::CountTileFlags(Grid, TileFrozenCounts, TileBlockedCounts);
 
 	CVarDebugDraw = IConsoleManager::Get().RegisterConsoleVariable(
 		TEXT("fluid.DebugDraw"),
 		0,
-		TEXT("Draw debug boxes for fluid cells. 1=on, 0=off."),
+		TEXT("Draw the batched fluid debug view. 1=on, 0=off."),
 		ECVF_Cheat
 	);
 
-	GetWorld()->GetTimerManager().SetTimer(
-		SimTimerHandle,
-		FTimerDelegate::CreateUObject(this, &UFluidSubsystem::SimStep),
-		SimStepRate,
-		/*bLoop=*/true
+	CVarDebugDrawMode = IConsoleManager::Get().RegisterConsoleVariable(
+		TEXT("fluid.DebugDrawMode"),
+		-1,
+		TEXT("Debug view mode. -1=use subsystem setting, 0=depth, 1=velocity, 2=frozen/blocked, 3=active tiles, 4=step cost, 5=lakes, 6=basins."),
+		ECVF_Cheat
+	);
+
+	CmdRebuildTerrainCache = IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("fluid.RebuildTerrainCache"),
+		TEXT("Re-bake terrain for the current level and rewrite its cooked fluid terrain cache."),
+		FConsoleCommandDelegate::CreateUObject(this, &UFluidSubsystem::RebuildTerrainCache),
+		ECVF_Cheat
 	);
+
+	TerrainTraceDelegate.BindUObject(this, &UFluidSubsystem::OnTerrainTraceDone);
+	TerrainRebakeDelegate.BindUObject(this, &UFluidSubsystem::OnTerrainRebakeTraceDone);
 }
 
 void UFluidSubsystem::Deinitialize()
@@ -43,7 +91,19 @@ void UFluidSubsystem::Deinitialize()
 	if (UWorld* World = GetWorld())
 	{
 		World->GetTimerManager().ClearTimer(SimTimerHandle);
+		World->GetTimerManager().ClearTimer(TerrainBakeHandle);
+		World->GetTimerManager().ClearTimer(PrewarmPollHandle);
+	}
+	TerrainTraceDelegate.Unbind();
+
+	// The worker steps its own copy, but the task must finish before the module can unload
+	if (PrewarmJob)
+	{
+		PrewarmJob->bCancelled = true;
+		PrewarmTask.Wait();
+		PrewarmJob.Reset();
 	}
+	TerrainRebakeDelegate.Unbind();
 
 	if (CVarDebugDraw)
 	{
@@ -51,6 +111,40 @@ void UFluidSubsystem::Deinitialize()
 		CVarDebugDraw = nullptr;
 	}
 
+	if (CVarDebugDrawMode)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(CVarDebugDrawMode);
+		CVarDebugDrawMode = nullptr;
+	}
+
+	if (CmdRebuildTerrainCache)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(CmdRebuildTerrainCache);
+		CmdRebuildTerrainCache = nullptr;
+	}
+
+	DebugComponent = nullptr;
+	Watches.Empty();
+	Regions.Empty();
+	Inflows.Empty();
+	Lakes.Empty();
+	Basins.Empty();
+	ContributorRemoved.Empty();
+	ReleasedContributors.Empty();
+	RewindBuffer.Reset();
+	GridSnapshot.Reset();
+
+	// The views die with the arena block, which goes back to the pool for the next world
+	Grid = TArrayView<FFluidCell>();
+	NeighborMasks = TArrayView<uint8>();
+	FluidDeltas = TArrayView<float>();
+	FlowVelocityDeltas = TArrayView<FVector2D>();
+	RemovalPlane = TArrayView<float>();
+	InflowPlane = TArrayView<float>();
+	ForcePlane = TArrayView<FVector2D>();
+	CellStepCost = TArrayView<uint8>();
+	Arena.Release();
+
 	Super::Deinitialize();
 }
 
@@ -64,135 +158,2008 @@ void UFluidSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 // Terrain Baking
 // ---------------------------------------------------------------------------
 
-void UFluidSubsystem::BakeTerrainHeights()
+void UFluidSubsystem::BakeTerrainHeights()
+{
+	bTerrainReady = false;
+	TerrainBakeNextIssue = 0;
+	TerrainBakeCompleted = 0;
+
+	if (TryLoadTerrainCache())
+	{
+		bTerrainNeedsCacheSave = false;
+		FinishTerrainBake();
+		return;
+	}
+
+	BakeTerrainFromLevel();
+}
+
+void UFluidSubsystem::BakeTerrainFromLevel()
+{
+	UWorld* World = GetWorld();
+	if (!World) { return; }
+
+	bTerrainNeedsCacheSave = true;
+	TerrainBakeQueue.Reset(FluidConstants::TotalCells);
+
+	// Landscapes overlapping the grid, sampled directly from their collision heightfields
+	TArray<const ALandscapeProxy*, TInlineAllocator<4>> Landscapes;
+	int32 SamplesPerAxis = 1;
+
+	if (TerrainSource != EFluidTerrainSource::LineTrace)
+	{
+		const float GridExtent = FluidConstants::GridSize * CellWorldSize;
+		const FBox GridBox(
+			FVector(GridWorldOrigin.X, GridWorldOrigin.Y, -FluidConstants::TerrainTraceHalfHeight),
+			FVector(GridWorldOrigin.X + GridExtent, GridWorldOrigin.Y + GridExtent, FluidConstants::TerrainTraceHalfHeight));
+
+		for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
+		{
+			if (!It->GetComponentsBoundingBox().Intersect(GridBox)) { continue; }
+			Landscapes.Add(*It);
+
+			// One sample per landscape quad; finer landscapes get more samples per cell
+			const float QuadSize = FMath::Max(It->GetActorScale3D().X, 1.f);
+			SamplesPerAxis = FMath::Max(SamplesPerAxis, FMath::CeilToInt(CellWorldSize / QuadSize));
+		}
+		SamplesPerAxis = FMath::Min(SamplesPerAxis, FluidConstants::MaxLandscapeSamplesPerAxis);
+
+		if (Landscapes.Num() == 0 && TerrainSource == EFluidTerrainSource::Landscape)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FluidSubsystem: TerrainSource is Landscape but no landscape overlaps the grid, tracing instead"));
+		}
+	}
+
+	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+	{
+		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		{
+			float Height = 0.f;
+			if (Landscapes.Num() > 0 && SampleLandscapeCell(Landscapes, X, Y, SamplesPerAxis, Height))
+			{
+				Grid[GetCellIndex(X, Y)].TerrainHeight = Height;
+				continue;
+			}
+			TerrainBakeQueue.Add(FIntPoint(X, Y));
+		}
+	}
+
+	if (TerrainBakeQueue.Num() == 0)
+	{
+		FinishTerrainBake();
+		return;
+	}
+
+	IssueTerrainBakeBatch();
+}
+
+bool UFluidSubsystem::SampleLandscapeCell(TConstArrayView<const ALandscapeProxy*> Landscapes, int32 X, int32 Y, int32 SamplesPerAxis, float& OutHeight) const
+{
+	const float Step = CellWorldSize / SamplesPerAxis;
+	const float CellMinX = GridWorldOrigin.X + X * CellWorldSize;
+	const float CellMinY = GridWorldOrigin.Y + Y * CellWorldSize;
+
+	float MinHeight = TNumericLimits<float>::Max();
+	float MaxHeight = TNumericLimits<float>::Lowest();
+	float SumHeight = 0.f;
+	int32 NumSamples = 0;
+
+	for (int32 SY = 0; SY < SamplesPerAxis; ++SY)
+	{
+		for (int32 SX = 0; SX < SamplesPerAxis; ++SX)
+		{
+			const FVector SamplePos(CellMinX + (SX + 0.5f) * Step, CellMinY + (SY + 0.5f) * Step, 0.f);
+
+			for (const ALandscapeProxy* Landscape : Landscapes)
+			{
+				const TOptional<float> Height = Landscape->GetHeightAtLocation(SamplePos, EHeightfieldSource::Complex);
+				if (!Height.IsSet()) { continue; }
+
+				MinHeight = FMath::Min(MinHeight, Height.GetValue());
+				MaxHeight = FMath::Max(MaxHeight, Height.GetValue());
+				SumHeight += Height.GetValue();
+				++NumSamples;
+				break;
+			}
+		}
+	}
+
+	// Cells straddling the landscape edge use whatever samples landed on it
+	if (NumSamples == 0) { return false; }
+
+	switch (LandscapeFilter)
+	{
+	case EFluidTerrainFilter::Min:	OutHeight = MinHeight; break;
+	case EFluidTerrainFilter::Max:	OutHeight = MaxHeight; break;
+	case EFluidTerrainFilter::Mean:
+	default:						OutHeight = SumHeight / NumSamples; break;
+	}
+	return true;
+}
+
+void UFluidSubsystem::IssueTerrainBakeBatch()
+{
+	UWorld* World = GetWorld();
+	if (!World) { return; }
+
+	// Async traces are gathered and executed in parallel on worker threads during the
+	// next world tick; results come back through OnTerrainTraceDone on the game thread.
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(FluidTerrainBake), /*bTraceComplex=*/false);
+	const int32 BatchEnd = FMath::Min(TerrainBakeNextIssue + TerrainBakeBatchSize, TerrainBakeQueue.Num());
+
+	for (; TerrainBakeNextIssue < BatchEnd; ++TerrainBakeNextIssue)
+	{
+		const FIntPoint Cell = TerrainBakeQueue[TerrainBakeNextIssue];
+		const FVector CellCenter = CellToWorld(Cell.X, Cell.Y);
+
+		World->AsyncLineTraceByChannel(
+			EAsyncTraceType::Single,
+			FVector(CellCenter.X, CellCenter.Y, FluidConstants::TerrainTraceHalfHeight),
+			FVector(CellCenter.X, CellCenter.Y, -FluidConstants::TerrainTraceHalfHeight),
+			ECC_WorldStatic,
+			Params,
+			FCollisionResponseParams::DefaultResponseParam,
+			&TerrainTraceDelegate,
+			static_cast<uint32>(GetCellIndex(Cell.X, Cell.Y))
+		);
+	}
+
+	OnTerrainBakeProgress.Broadcast(GetTerrainBakeProgress());
+
+	if (TerrainBakeNextIssue < TerrainBakeQueue.Num())
+	{
+		TerrainBakeHandle = World->GetTimerManager().SetTimerForNextTick(this, &UFluidSubsystem::IssueTerrainBakeBatch);
+	}
+}
+
+void UFluidSubsystem::OnTerrainTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const int32 Idx = static_cast<int32>(TraceDatum.UserData);
+	if (Grid.IsValidIndex(Idx))
+	{
+		const bool bHit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+		Grid[Idx].TerrainHeight = bHit ? TraceDatum.OutHits[0].ImpactPoint.Z : 0.f;
+	}
+
+	if (++TerrainBakeCompleted == TerrainBakeQueue.Num())
+	{
+		FinishTerrainBake();
+	}
+}
+
+void UFluidSubsystem::RebakeTerrainInBounds(FBox Bounds)
+{
+	UWorld* World = GetWorld();
+	if (!World || !Bounds.IsValid) { return; }
+
+	const FIntPoint MinCell = WorldToCell(Bounds.Min);
+	const FIntPoint MaxCell = WorldToCell(Bounds.Max);
+	const int32 MinX = FMath::Max(MinCell.X, 0);
+	const int32 MinY = FMath::Max(MinCell.Y, 0);
+	const int32 MaxX = FMath::Min(MaxCell.X, FluidConstants::GridSize - 1);
+	const int32 MaxY = FMath::Min(MaxCell.Y, FluidConstants::GridSize - 1);
+	if (MinX > MaxX || MinY > MaxY) { return; }
+
+	// Regions are footprint-sized, so the whole set goes out in one batch
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(FluidTerrainRebake), /*bTraceComplex=*/false);
+
+	for (int32 Y = MinY; Y <= MaxY; ++Y)
+	{
+		for (int32 X = MinX; X <= MaxX; ++X)
+		{
+			const FVector CellCenter = CellToWorld(X, Y);
+			if (CellCenter.X < Bounds.Min.X || CellCenter.X > Bounds.Max.X
+				|| CellCenter.Y < Bounds.Min.Y || CellCenter.Y > Bounds.Max.Y) { continue; }
+
+			World->AsyncLineTraceByChannel(
+				EAsyncTraceType::Single,
+				FVector(CellCenter.X, CellCenter.Y, FluidConstants::TerrainTraceHalfHeight),
+				FVector(CellCenter.X, CellCenter.Y, -FluidConstants::TerrainTraceHalfHeight),
+				ECC_WorldStatic,
+				Params,
+				FCollisionResponseParams::DefaultResponseParam,
+				&TerrainRebakeDelegate,
+				static_cast<uint32>(GetCellIndex(X, Y))
+			);
+			++RebakeTracesPending;
+		}
+	}
+}
+
+void UFluidSubsystem::OnTerrainRebakeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	RebakeTracesPending = FMath::Max(0, RebakeTracesPending - 1);
+
+	const int32 Idx = static_cast<int32>(TraceDatum.UserData);
+	if (!Grid.IsValidIndex(Idx)) { return; }
+
+	const bool bHit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	const float NewHeight = bHit ? TraceDatum.OutHits[0].ImpactPoint.Z : 0.f;
+	if (FMath::IsNearlyEqual(Grid[Idx].TerrainHeight, NewHeight)) { return; }
+
+	DissolveLakeAtCell(Idx);
+	Grid[Idx].TerrainHeight = NewHeight;
+	++TerrainRevision;
+	bBasinsDirty = true;
+	WakeCell(FluidGrid::CellX(Idx), FluidGrid::CellY(Idx));
+}
+
+void UFluidSubsystem::FinishTerrainBake()
+{
+	TerrainBakeQueue.Empty();
+	TerrainBakeNextIssue = 0;
+	TerrainBakeCompleted = 0;
+	bTerrainReady = true;
+	++TerrainRevision;
+
+#if WITH_EDITOR
+	// Editor sessions keep the cooked cache current; packaged builds only ever read it
+	if (bTerrainNeedsCacheSave)
+	{
+		SaveTerrainCache();
+	}
+#endif
+
+	BuildBasins();
+
+	if (StartPrewarm()) { return; }
+	CompleteTerrainSetup();
+}
+
+void UFluidSubsystem::CompleteTerrainSetup()
+{
+	GridSnapshot.Reset();
+	OnTerrainBakeProgress.Broadcast(1.f);
+	StartSimulation();
+	OnTerrainReady.Broadcast();
+}
+
+float UFluidSubsystem::GetTerrainBakeProgress() const
+{
+	if (bTerrainReady) { return 1.f; }
+	return TerrainBakeQueue.Num() > 0
+		? static_cast<float>(TerrainBakeCompleted) / TerrainBakeQueue.Num()
+		: 0.f;
+}
+
+uint64 UFluidSubsystem::ComputeTerrainGeometryHash() const
+{
+	// Source settings change the baked heights as much as the geometry does
+	const uint64 Parts[2] = {
+		FFluidTerrainCache::ComputeGeometryHash(GetWorld(), GridWorldOrigin, CellWorldSize, FluidConstants::GridSize),
+		(static_cast<uint64>(TerrainSource) << 8) | static_cast<uint64>(LandscapeFilter)
+	};
+	return FXxHash64::HashBuffer(Parts, sizeof(Parts)).Hash;
+}
+
+bool UFluidSubsystem::TryLoadTerrainCache()
+{
+	UWorld* World = GetWorld();
+	if (!World) { return false; }
+
+	const FString Path = FFluidTerrainCache::GetCachePath(World);
+	FFluidTerrainCache Cache;
+	if (!Cache.Load(Path, ComputeTerrainGeometryHash())) { return false; }
+	if (Cache.GridSize != FluidConstants::GridSize) { return false; }
+
+	// The cache is row-major whatever the in-memory cell layout
+	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	{
+		Grid[I].TerrainHeight = Cache.TerrainHeights[FluidGrid::RowMajorIndex(I)];
+		NeighborMasks[I] = Cache.NeighborMasks[FluidGrid::RowMajorIndex(I)];
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FluidSubsystem: loaded terrain cache %s"), *Path);
+	return true;
+}
+
+void UFluidSubsystem::SaveTerrainCache() const
+{
+	UWorld* World = GetWorld();
+	if (!World) { return; }
+
+	FFluidTerrainCache Cache;
+	Cache.GeometryHash = ComputeTerrainGeometryHash();
+	Cache.GridSize = FluidConstants::GridSize;
+	Cache.CellWorldSize = CellWorldSize;
+	Cache.GridWorldOrigin = GridWorldOrigin;
+	Cache.TerrainHeights.SetNumUninitialized(FluidConstants::TotalCells);
+	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	{
+		Cache.TerrainHeights[FluidGrid::RowMajorIndex(I)] = Grid[I].TerrainHeight;
+	}
+
+	// Store the static-terrain masks only; levee blocks are runtime state
+	Cache.NeighborMasks.SetNumUninitialized(FluidConstants::TotalCells);
+	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+	{
+		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		{
+			uint8 Mask = 0;
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				if (IsValidCell(X + FluidConstants::NeighborDX[Dir], Y + FluidConstants::NeighborDY[Dir]))
+				{
+					Mask |= 1 << Dir;
+				}
+			}
+			Cache.NeighborMasks[Y * FluidConstants::GridSize + X] = Mask;
+		}
+	}
+
+	const FString Path = FFluidTerrainCache::GetCachePath(World);
+	if (Cache.Save(Path))
+	{
+		UE_LOG(LogTemp, Log, TEXT("FluidSubsystem: wrote terrain cache %s"), *Path);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FluidSubsystem: failed to write terrain cache %s"), *Path);
+	}
+}
+
+void UFluidSubsystem::RebuildTerrainCache()
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld()) { return; }
+
+	// Stop the sim and any bake in flight, then bake from the level. FinishTerrainBake saves.
+	World->GetTimerManager().ClearTimer(SimTimerHandle);
+	World->GetTimerManager().ClearTimer(TerrainBakeHandle);
+	DissolveAllLakes();
+
+	bTerrainReady = false;
+	TerrainBakeNextIssue = 0;
+	TerrainBakeCompleted = 0;
+	BakeTerrainFromLevel();
+
+#if !WITH_EDITOR
+	UE_LOG(LogTemp, Warning, TEXT("FluidSubsystem: terrain re-baked, but the cache is only written from editor builds"));
+#endif
+}
+
+void UFluidSubsystem::RebuildNeighborMasks()
+{
+	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+	{
+		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		{
+			uint8 Mask = 0;
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				const int32 NX = X + FluidConstants::NeighborDX[Dir];
+				const int32 NY = Y + FluidConstants::NeighborDY[Dir];
+				if (IsValidCell(NX, NY) && !Grid[GetCellIndex(NX, NY)].bBlocked)
+				{
+					Mask |= 1 << Dir;
+				}
+			}
+			NeighborMasks[GetCellIndex(X, Y)] = Mask;
+		}
+	}
+}
+
+void UFluidSubsystem::StartSimulation()
+{
+	UWorld* World = GetWorld();
+	if (!World || World->GetTimerManager().IsTimerActive(SimTimerHandle)) { return; }
+
+	// Fresh terrain: let the first step decide which tiles can sleep
+	AwakeTiles.SetRange(0, FluidConstants::TotalTiles, true);
+
+	World->GetTimerManager().SetTimer(
+		SimTimerHandle,
+		FTimerDelegate::CreateUObject(this, &UFluidSubsystem::SimStep),
+		SimStepRate,
+		/*bLoop=*/true
+	);
+}
+
+// ---------------------------------------------------------------------------
+// Pre-warm
+// ---------------------------------------------------------------------------
+
+bool UFluidSubsystem::StartPrewarm()
+{
+	UWorld* World = GetWorld();
+	if (!World || PrewarmJob) { return false; }
+
+	// Only the first bake of a level pre-warms; a later rebake must not replace live fluid
+	if (World->GetTimerManager().IsTimerActive(SimTimerHandle)) { return false; }
+
+	const AFluidPrewarm* Prewarm = nullptr;
+	for (TActorIterator<AFluidPrewarm> It(World); It; ++It)
+	{
+		Prewarm = *It;
+		break;
+	}
+	if (!Prewarm || !Prewarm->HasWork()) { return false; }
+
+	// Start from dry terrain with only the pre-warm sources running, so the result depends on nothing else
+	TSharedPtr<FFluidSimState, ESPMode::ThreadSafe> State = MakeShared<FFluidSimState, ESPMode::ThreadSafe>();
+	CaptureSimState(*State);
+	for (FFluidCell& Cell : State->Grid)
+	{
+		Cell.FluidVolume = 0.f;
+		Cell.FlowVelocity = FVector2D::ZeroVector;
+	}
+	State->AwakeTiles.SetRange(0, FluidConstants::TotalTiles, true);
+
+	State->InflowCells.Reset();
+	State->InflowVolumes.Reset();
+	for (const FFluidPrewarmSource& Source : Prewarm->Sources)
+	{
+		FFluidInflow Footprint;
+		BuildInflowFootprint(Prewarm->GetActorTransform().TransformPosition(Source.Location), Source.Radius, Footprint);
+
+		const float StepVolume = FMath::Max(0.f, Source.RatePerSecond) * State->StepSeconds;
+		for (int32 I = 0; I < Footprint.Cells.Num(); ++I)
+		{
+			State->InflowCells.Add(Footprint.Cells[I]);
+			State->InflowVolumes.Add(StepVolume * Footprint.Weights[I]);
+		}
+	}
+
+	const uint64 Key = ComputePrewarmKey(*State, Prewarm->ComputeDescriptionHash());
+
+	const FString Path = FFluidPrewarmCache::GetCachePath(World);
+	FFluidPrewarmCache Cache;
+	if (Cache.Load(Path, Key) && Cache.GridSize == FluidConstants::GridSize)
+	{
+		ApplyPrewarmVolumes(Cache.FluidVolumes);
+		UE_LOG(LogTemp, Log, TEXT("FluidSubsystem: loaded pre-warm cache %s"), *Path);
+		return false;
+	}
+
+	TSharedPtr<FPrewarmJob, ESPMode::ThreadSafe> Job = MakeShared<FPrewarmJob, ESPMode::ThreadSafe>();
+	Job->State = State;
+	Job->Key = Key;
+	Job->NumSteps = FMath::CeilToInt(Prewarm->Duration / State->StepSeconds);
+
+	// Steps depend on each other, so one worker runs them back to back; the game thread keeps loading
+	PrewarmJob = Job;
+	PrewarmTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]()
+	{
+		for (int32 Step = 0; Step < Job->NumSteps; ++Step)
+		{
+			if (Job->bCancelled) { return; }
+			Job->State->Step();
+			Job->StepsDone = Step + 1;
+		}
+	});
+
+	World->GetTimerManager().SetTimer(
+		PrewarmPollHandle,
+		FTimerDelegate::CreateUObject(this, &UFluidSubsystem::PollPrewarm),
+		FluidConstants::PrewarmPollInterval,
+		/*bLoop=*/true
+	);
+
+	UE_LOG(LogTemp, Log, TEXT("FluidSubsystem: pre-warming %d steps on a worker"), Job->NumSteps);
+	return true;
+}
+
+void UFluidSubsystem::PollPrewarm()
+{
+	if (!PrewarmJob) { return; }
+	if (!PrewarmTask.IsCompleted())
+	{
+		OnTerrainBakeProgress.Broadcast(GetPrewarmProgress());
+		return;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PrewarmPollHandle);
+	}
+
+	TSharedPtr<FPrewarmJob, ESPMode::ThreadSafe> Job = MoveTemp(PrewarmJob);
+
+	// The cache is row-major whatever the in-memory cell layout
+	FFluidPrewarmCache Cache;
+	Cache.Key = Job->Key;
+	Cache.GridSize = FluidConstants::GridSize;
+	Cache.FluidVolumes.SetNumUninitialized(FluidConstants::TotalCells);
+	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	{
+		Cache.FluidVolumes[FluidGrid::RowMajorIndex(I)] = Job->State->Grid[I].FluidVolume;
+	}
+	ApplyPrewarmVolumes(Cache.FluidVolumes);
+
+#if WITH_EDITOR
+	// Same rule as the terrain cache: editor sessions write it, packaged builds only read it
+	const FString Path = FFluidPrewarmCache::GetCachePath(GetWorld());
+	if (Cache.Save(Path))
+	{
+		UE_LOG(LogTemp, Log, TEXT("FluidSubsystem: wrote pre-warm cache %s"), *Path);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FluidSubsystem: failed to write pre-warm cache %s"), *Path);
+	}
+#endif
+
+	CompleteTerrainSetup();
+}
+
+float UFluidSubsystem::GetPrewarmProgress() const
+{
+	if (!PrewarmJob || PrewarmJob->NumSteps <= 0) { return 1.f; }
+	return static_cast<float>(PrewarmJob->StepsDone) / PrewarmJob->NumSteps;
+}
+
+void UFluidSubsystem::ApplyPrewarmVolumes(TConstArrayView<float> RowMajorVolumes)
+{
+	DissolveAllLakes();
+
+	// Velocities start at rest; the first few steps rebuild them from the surface gradient
+	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	{
+		Grid[I].FluidVolume = RowMajorVolumes[FluidGrid::RowMajorIndex(I)];
+		Grid[I].FlowVelocity = FVector2D::ZeroVector;
+	}
+	AwakeTiles.SetRange(0, FluidConstants::TotalTiles, true);
+}
+
+uint64 UFluidSubsystem::ComputePrewarmKey(const FFluidSimState& State, uint64 DescriptionHash) const
+{
+	// Row-major, so a cache written under one cell layout still matches under another
+	FXxHash64Builder Builder;
+	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	{
+		const int32 Idx = FluidGrid::CellIndex(I % FluidConstants::GridSize, I / FluidConstants::GridSize);
+		const FFluidCell& Cell = State.Grid[Idx];
+		const uint8 Flags = (Cell.bBlocked ? 1 : 0) | (Cell.bFrozen ? 2 : 0);
+		Builder.Update(&Cell.TerrainHeight, sizeof(Cell.TerrainHeight));
+		Builder.Update(&State.NeighborMasks[Idx], sizeof(uint8));
+		Builder.Update(&Flags, sizeof(Flags));
+	}
+
+	const float Tuning[4] = { State.Params.FlowRate, State.Params.OscillationClamp, State.Params.VelocityDamping, State.StepSeconds };
+	Builder.Update(Tuning, sizeof(Tuning));
+	Builder.Update(&DescriptionHash, sizeof(DescriptionHash));
+	return Builder.Finalize().Hash;
+}
+
+// ---------------------------------------------------------------------------
+// Flow Simulation — Accumulator Pattern
+// ---------------------------------------------------------------------------
+
+void UFluidSubsystem::SimStep()
+{
+	// Rebake traces land one cell at a time over several frames; rebuild once the last one is in
+	if (bBasinsDirty && RebakeTracesPending == 0)
+	{
+		BuildBasins();
+	}
+
+	// Scheduled effects (towers, etc.) mutate the grid here so every step sees them at the same point
+	PreStepDelegate.Broadcast(SimStepRate);
+	ApplyInflows();
+	ResolveEffects();
+
+	const bool bDrawDebug = IsDebugDrawEnabled();
+	const bool bRecordStepCost = bDrawDebug && GetActiveDebugMode() == EFluidDebugMode::StepCost;
+	if (bRecordStepCost)
+	{
+		FMemory::Memzero(CellStepCost.GetData(), CellStepCost.Num() * sizeof(uint8));
+	}
+
+	FFluidStepContext Ctx;
+	Ctx.Grid = Grid;
+	Ctx.NeighborMasks = NeighborMasks;
+	Ctx.FluidDeltas = FluidDeltas;
+	Ctx.FlowVelocityDeltas = FlowVelocityDeltas;
+	Ctx.AwakeTiles = &AwakeTiles;
+	Ctx.StepTiles = &StepTiles;
+	Ctx.TileFrozenCounts = TileFrozenCounts;
+	Ctx.TileBlockedCounts = TileBlockedCounts;
+	Ctx.HeldCells = &LakeHeldCells;
+	Ctx.TileHeldCounts = TileHeldCounts;
+	Ctx.WetTileMask = &WetTileMask;
+	Ctx.TileVolumes = TileVolumes;
+	if (bRecordStepCost)
+	{
+		Ctx.StepCost = CellStepCost;
+	}
+	FluidKernel::StepFlow(GetStepParams(), Ctx);
+
+	if (bEnablePoolSolve)
+	{
+		PoolSolveAccumulator += SimStepRate;
+		if (PoolSolveAccumulator >= PoolSolveInterval)
+		{
+			PoolSolveAccumulator = 0.f;
+
+			// Same gates as lake detection, so sheets and rivers stay with the cell step
+			FFluidPoolParams PoolParams;
+			PoolParams.MinDepth = LakeMinDepth;
+			PoolParams.MaxSurfaceRange = LakeFlatness;
+			PoolParams.MaxSpeed = LakeMaxSpeed;
+			PoolParams.Relaxation = PoolRelaxation;
+			PoolParams.NumLevels = PoolSolveLevels;
+			FluidKernel::RelaxPools(PoolParams, Ctx);
+		}
+	}
+
+	if (bEnableLakes)
+	{
+		LakeDetectAccumulator += SimStepRate;
+		if (LakeDetectAccumulator >= LakeDetectInterval)
+		{
+			LakeDetectAccumulator = 0.f;
+			DetectLakes();
+		}
+		LevelLakes();
+	}
+	else if (Lakes.Num() > 0)
+	{
+		DissolveAllLakes();
+	}
+
+	++SimStepCount;
+	GridSnapshot.Reset();
+	if (bEnableRewind)
+	{
+		const int32 HistorySteps = FMath::CeilToInt(RewindHistorySeconds / SimStepRate);
+		RewindBuffer.Configure(HistorySteps, RewindKeyframeInterval, static_cast<SIZE_T>(RewindBudgetMB) * 1024 * 1024);
+		RewindBuffer.Record(SimStepCount, Grid);
+	}
+	else if (!RewindBuffer.IsEmpty())
+	{
+		RewindBuffer.Reset();
+	}
+
+	// Push grid data to render targets for the surface renderer
+	UpdateRenderTargets();
+
+	EvaluateWatches();
+
+	// Debug draw
+	if (bDrawDebug)
+	{
+		UpdateDebugView();
+	}
+	else if (DebugComponent && DebugComponent->IsVisible())
+	{
+		DebugComponent->SetVisibility(false);
+	}
+}
+
+FFluidStepParams UFluidSubsystem::GetStepParams() const
+{
+	FFluidStepParams Params;
+	Params.FlowRate = FlowRate;
+	Params.OscillationClamp = OscillationClamp;
+	Params.VelocityDamping = VelocityDamping;
+	return Params;
+}
+
+void UFluidSubsystem::CaptureSimState(FFluidSimState& OutState) const
+{
+	OutState.Params = GetStepParams();
+	OutState.StepSeconds = SimStepRate;
+	OutState.Grid.Reset();
+	OutState.Grid.Append(Grid.GetData(), Grid.Num());
+	OutState.NeighborMasks.Reset();
+	OutState.NeighborMasks.Append(NeighborMasks.GetData(), NeighborMasks.Num());
+
+	// Lake interiors are closed off for the live step only; the copy has no lakes, so open them again
+	for (const FFluidLake& Lake : Lakes)
+	{
+		for (const int32 Idx : Lake.InteriorCells)
+		{
+			const int32 X = FluidGrid::CellX(Idx);
+			const int32 Y = FluidGrid::CellY(Idx);
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				OutState.NeighborMasks[GetCellIndex(X + FluidConstants::NeighborDX[Dir], Y + FluidConstants::NeighborDY[Dir])] |= 1 << (Dir ^ 1);
+			}
+		}
+	}
+	OutState.AwakeTiles = AwakeTiles;
+
+	OutState.InflowCells.Reset();
+	OutState.InflowVolumes.Reset();
+	for (const FFluidInflow& Inflow : Inflows)
+	{
+		float Rate = Inflow.RatePerSecond;
+		if (const UCurveFloat* Schedule = Inflow.Schedule.Get())
+		{
+			Rate *= FMath::Max(0.f, Schedule->GetFloatValue(Inflow.ElapsedSeconds));
+		}
+
+		for (int32 I = 0; I < Inflow.Cells.Num(); ++I)
+		{
+			OutState.InflowCells.Add(Inflow.Cells[I]);
+			OutState.InflowVolumes.Add(Rate * SimStepRate * Inflow.Weights[I]);
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Rewind
+// ---------------------------------------------------------------------------
+
+bool UFluidSubsystem::RewindToStep(int32 Step)
+{
+	FFluidRewindFrame Frame;
+	if (!RewindBuffer.Reconstruct(Step, Frame)) { return false; }
+
+	// Release held interiors before the frame replaces them; detection rebuilds lakes from the restored cells
+	DissolveAllLakes();
+
+	// Blocked cells hold no fluid now, whatever they held then
+	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	{
+		FFluidCell& Cell = Grid[I];
+		if (Cell.bBlocked) { continue; }
+		Cell.FluidVolume = Frame.FluidVolumes[I];
+		Cell.FlowVelocity = FVector2D(Frame.FlowVelocities[I]);
+	}
+
+	RewindBuffer.TruncateAfter(Step);
+	SimStepCount = Step;
+	GridSnapshot.Reset();
+	AwakeTiles.SetRange(0, FluidConstants::TotalTiles, true);
+	UpdateRenderTargets();
+	return true;
+}
+
+bool UFluidSubsystem::RewindSeconds(float Seconds)
+{
+	const int32 Steps = FMath::RoundToInt(FMath::Max(0.f, Seconds) / SimStepRate);
+	return RewindToStep(FMath::Max(SimStepCount - Steps, RewindBuffer.GetOldestStep()));
+}
+
+// ---------------------------------------------------------------------------
+// Lakes
+// ---------------------------------------------------------------------------
+
+namespace
+{
+	/**
+	 * Level at which Volume exactly fills Cells (sorted by terrain, ascending). Sweeps upward,
+	 * adding one cell to the wetted set at a time until the level stops short of the next cell.
+	 */
+	float SolveLakeLevel(TConstArrayView<FFluidCell> Grid, TConstArrayView<int32> SortedCells, float Volume, int32& OutWetCount)
+	{
+		float TerrainSum = 0.f;
+		float Level = Grid[SortedCells[0]].TerrainHeight;
+		for (int32 K = 0; K < SortedCells.Num(); ++K)
+		{
+			TerrainSum += Grid[SortedCells[K]].TerrainHeight;
+			Level = (Volume + TerrainSum) / (K + 1);
+			OutWetCount = K + 1;
+			if (K + 1 == SortedCells.Num() || Level <= Grid[SortedCells[K + 1]].TerrainHeight) { break; }
+		}
+		return Level;
+	}
+}
+
+void UFluidSubsystem::DetectLakes()
+{
+	// Cells already in a lake are skipped, so settled lakes cost the sweep one id test per cell
+	const double MaxSpeedSq = FMath::Square(static_cast<double>(LakeMaxSpeed));
+	auto IsCandidate = [this, MaxSpeedSq](int32 Idx)
+	{
+		const FFluidCell& Cell = Grid[Idx];
+		return CellLakeIds[Idx] == INDEX_NONE && !Cell.bFrozen && !Cell.bBlocked && Cell.FluidVolume >= LakeMinDepth
+			&& Cell.FlowVelocity.SizeSquared() <= MaxSpeedSq;
+	};
+
+	TBitArray<> Visited(false, FluidConstants::TotalCells);
+	TArray<int32> Component;
+	TArray<int32, TInlineAllocator<4>> MetLakes;
+
+	for (int32 Seed = 0; Seed < FluidConstants::TotalCells; ++Seed)
+	{
+		if (Visited[Seed] || !IsCandidate(Seed)) { continue; }
+
+		// Flood fill over open neighbours, keeping the whole component's surface range within
+		// LakeFlatness; a per-edge test would chain a river down its slope into one lake
+		Component.Reset();
+		Component.Add(Seed);
+		MetLakes.Reset();
+		Visited[Seed] = true;
+		float MinSurface = Grid[Seed].GetSurfaceHeight();
+		float MaxSurface = MinSurface;
+		for (int32 Head = 0; Head < Component.Num(); ++Head)
+		{
+			const int32 Idx = Component[Head];
+			const int32 X = FluidGrid::CellX(Idx);
+			const int32 Y = FluidGrid::CellY(Idx);
+			const uint8 OpenMask = NeighborMasks[Idx];
+
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				if (!(OpenMask & (1 << Dir))) { continue; }
+				const int32 NIdx = GetCellIndex(X + FluidConstants::NeighborDX[Dir], Y + FluidConstants::NeighborDY[Dir]);
+				if (Visited[NIdx]) { continue; }
+
+				// A lake reads as one surface at its level
+				const int32 NLake = CellLakeIds[NIdx];
+				if (NLake == INDEX_NONE && !IsCandidate(NIdx)) { continue; }
+
+				// Left unvisited on rejection, so a later seed can still claim it for its own lake
+				const float NSurface = NLake != INDEX_NONE ? Lakes[NLake].Level : Grid[NIdx].GetSurfaceHeight();
+				if (FMath::Max(MaxSurface, NSurface) - FMath::Min(MinSurface, NSurface) > LakeFlatness) { continue; }
+
+				MinSurface = FMath::Min(MinSurface, NSurface);
+				MaxSurface = FMath::Max(MaxSurface, NSurface);
+				if (NLake != INDEX_NONE)
+				{
+					MetLakes.AddUnique(NLake);
+					continue;
+				}
+				Visited[NIdx] = true;
+				Component.Add(NIdx);
+			}
+		}
+
+		// New water bridging two lakes: drop them all and let the next sweep find them as one.
+		// Highest index first, so the swap-removes never move a lake still to be dropped.
+		if (MetLakes.Num() > 1)
+		{
+			MetLakes.Sort(TGreater<int32>());
+			for (const int32 LakeIndex : MetLakes)
+			{
+				DissolveLake(LakeIndex);
+			}
+			continue;
+		}
+
+		// Rising water: the lake takes the new cells whatever their number
+		if (MetLakes.Num() == 1)
+		{
+			const int32 LakeIndex = MetLakes[0];
+			FFluidLake& Lake = Lakes[LakeIndex];
+			ReleaseLakeInterior(Lake);
+			for (const int32 Idx : Component)
+			{
+				CellLakeIds[Idx] = LakeIndex;
+			}
+			Lake.Cells.Append(Component);
+			BuildLake(LakeIndex);
+			continue;
+		}
+
+		if (Component.Num() < LakeMinCells) { continue; }
+
+		const int32 LakeIndex = Lakes.Num();
+		Lakes.AddDefaulted_GetRef().Cells = Component;
+		for (const int32 Idx : Component)
+		{
+			CellLakeIds[Idx] = LakeIndex;
+		}
+		BuildLake(LakeIndex);
+	}
+}
+
+void UFluidSubsystem::BuildLake(int32 LakeIndex)
+{
+	FFluidLake& Lake = Lakes[LakeIndex];
+	check(Lake.InteriorCells.Num() == 0);
+
+	Lake.RimCells.Reset();
+	Lake.RimTiles.Reset();
+	Lake.TerrainSum = 0.0;
+	Lake.RimTerrainSum = 0.0;
+	Lake.MaxTerrain = TNumericLimits<float>::Lowest();
+	Lake.InteriorVolume = 0.0;
+	double Volume = 0.0;
+
+	for (const int32 Idx : Lake.Cells)
+	{
+		const FFluidCell& Cell = Grid[Idx];
+		const int32 X = FluidGrid::CellX(Idx);
+		const int32 Y = FluidGrid::CellY(Idx);
+		Lake.TerrainSum += Cell.TerrainHeight;
+		Lake.MaxTerrain = FMath::Max(Lake.MaxTerrain, Cell.TerrainHeight);
+		Volume += Cell.FluidVolume;
+
+		bool bInterior = true;
+		for (int32 Dir = 0; Dir < 4 && bInterior; ++Dir)
+		{
+			const int32 NX = X + FluidConstants::NeighborDX[Dir];
+			const int32 NY = Y + FluidConstants::NeighborDY[Dir];
+			bInterior = IsValidCell(NX, NY) && CellLakeIds[GetCellIndex(NX, NY)] == LakeIndex;
+		}
+
+		if (bInterior)
+		{
+			Lake.InteriorCells.Add(Idx);
+			Lake.InteriorVolume += Cell.FluidVolume;
+			SetCellHeld(Idx, true);
+			continue;
+		}
+
+		Lake.RimCells.Add(Idx);
+		Lake.RimTerrainSum += Cell.TerrainHeight;
+		Lake.RimTiles.AddUnique(FluidGrid::TileOfCell(Idx));
+	}
+
+	// Level once this step so a freshly found pool equilibrates now rather than on its next disturbance
+	Lake.Level = static_cast<float>((Volume + Lake.TerrainSum) / Lake.Cells.Num());
+	Lake.bDirty = true;
+}
+
+void UFluidSubsystem::LevelLakes()
+{
+	for (int32 LakeIndex = Lakes.Num() - 1; LakeIndex >= 0; --LakeIndex)
+	{
+		FFluidLake& Lake = Lakes[LakeIndex];
+
+		// Only the rim trades with the grid; a lake whose rim did not step is still level
+		bool bTouched = Lake.bDirty;
+		for (int32 I = 0; I < Lake.RimTiles.Num() && !bTouched; ++I)
+		{
+			bTouched = StepTiles[Lake.RimTiles[I]];
+		}
+		if (!bTouched) { continue; }
+
+		double Volume = Lake.InteriorVolume;
+		for (const int32 Idx : Lake.RimCells)
+		{
+			Volume += Grid[Idx].FluidVolume;
+		}
+
+		// The highest cell drying out may cut the pool in two; leave it to the next detection sweep
+		const float Level = static_cast<float>((Volume + Lake.TerrainSum) / Lake.Cells.Num());
+		if (Level <= Lake.MaxTerrain)
+		{
+			DissolveLake(LakeIndex);
+			continue;
+		}
+
+		Lake.Level = Level;
+		for (const int32 Idx : Lake.RimCells)
+		{
+			FFluidCell& Cell = Grid[Idx];
+			const float NewVolume = Level - Cell.TerrainHeight;
+			const float Change = NewVolume - Cell.FluidVolume;
+			Cell.FluidVolume = NewVolume;
+
+			TileVolumes[FluidGrid::TileOfCell(Idx)] += Change;
+			if (FMath::Abs(Change) > FluidConstants::TileSleepVolumeEpsilon)
+			{
+				WakeCell(FluidGrid::CellX(Idx), FluidGrid::CellY(Idx));
+			}
+		}
+		Lake.InteriorVolume = Volume - (Lake.RimCells.Num() * static_cast<double>(Level) - Lake.RimTerrainSum);
+
+		// Nothing reads the interior but queries and rendering, so it only follows the level in steps
+		if (Lake.bDirty || FMath::Abs(Level - Lake.InteriorLevel) > FluidConstants::LakeInteriorRewriteEpsilon)
+		{
+			for (const int32 Idx : Lake.InteriorCells)
+			{
+				FFluidCell& Cell = Grid[Idx];
+				const float NewVolume = Level - Cell.TerrainHeight;
+				TileVolumes[FluidGrid::TileOfCell(Idx)] += NewVolume - Cell.FluidVolume;
+				Cell.FluidVolume = NewVolume;
+			}
+			Lake.InteriorLevel = Level;
+		}
+		Lake.bDirty = false;
+	}
+}
+
+void UFluidSubsystem::ReleaseLakeInterior(FFluidLake& Lake)
+{
+	if (Lake.InteriorCells.Num() == 0) { return; }
+
+	// The grid's copy lags InteriorVolume; spread the exact volume back out, lowest cells first
+	Lake.InteriorCells.Sort([this](int32 A, int32 B) { return Grid[A].TerrainHeight < Grid[B].TerrainHeight; });
+	int32 WetCount = 0;
+	const float Level = SolveLakeLevel(Grid, Lake.InteriorCells, FMath::Max(0.f, static_cast<float>(Lake.InteriorVolume)), WetCount);
+
+	for (const int32 Idx : Lake.InteriorCells)
+	{
+		FFluidCell& Cell = Grid[Idx];
+		const float NewVolume = FMath::Max(0.f, Level - Cell.TerrainHeight);
+		TileVolumes[FluidGrid::TileOfCell(Idx)] += NewVolume - Cell.FluidVolume;
+		Cell.FluidVolume = NewVolume;
+		SetCellHeld(Idx, false);
+	}
+	Lake.InteriorCells.Reset();
+	Lake.InteriorVolume = 0.0;
+}
+
+void UFluidSubsystem::SetCellHeld(int32 Idx, bool bHold)
+{
+	if (LakeHeldCells[Idx] == bHold) { return; }
+	LakeHeldCells[Idx] = bHold;
+
+	uint16& Count = TileHeldCounts[FluidGrid::TileOfCell(Idx)];
+	Count = bHold ? Count + 1 : Count - 1;
+
+	// Closed like a levee in its neighbours' masks. Lake cells are never blocked, so releasing reopens them.
+	const int32 X = FluidGrid::CellX(Idx);
+	const int32 Y = FluidGrid::CellY(Idx);
+	for (int32 Dir = 0; Dir < 4; ++Dir)
+	{
+		const int32 NX = X + FluidConstants::NeighborDX[Dir];
+		const int32 NY = Y + FluidConstants::NeighborDY[Dir];
+		if (!IsValidCell(NX, NY)) { continue; }
+
+		const uint8 TowardCell = 1 << (Dir ^ 1);
+		uint8& Mask = NeighborMasks[GetCellIndex(NX, NY)];
+		Mask = bHold ? (Mask & ~TowardCell) : (Mask | TowardCell);
+	}
+
+	if (bHold)
+	{
+		Grid[Idx].FlowVelocity = FVector2D::ZeroVector;
+	}
+	else
+	{
+		WakeCell(X, Y);
+	}
+}
+
+void UFluidSubsystem::NoteHeldCellWrite(int32 Idx, float Change)
+{
+	if (!LakeHeldCells[Idx]) { return; }
+
+	FFluidLake& Lake = Lakes[CellLakeIds[Idx]];
+	Lake.InteriorVolume += Change;
+	Lake.bDirty = true;
+}
+
+void UFluidSubsystem::DissolveLake(int32 LakeIndex)
+{
+	ReleaseLakeInterior(Lakes[LakeIndex]);
+	for (const int32 Idx : Lakes[LakeIndex].Cells)
+	{
+		CellLakeIds[Idx] = INDEX_NONE;
+	}
+
+	// Keep ids dense: the last lake takes this slot
+	const int32 LastIndex = Lakes.Num() - 1;
+	if (LakeIndex != LastIndex)
+	{
+		for (const int32 Idx : Lakes[LastIndex].Cells)
+		{
+			CellLakeIds[Idx] = LakeIndex;
+		}
+	}
+	Lakes.RemoveAtSwap(LakeIndex);
+}
+
+void UFluidSubsystem::DissolveAllLakes()
+{
+	while (Lakes.Num() > 0)
+	{
+		DissolveLake(Lakes.Num() - 1);
+	}
+}
+
+void UFluidSubsystem::DissolveLakeAtCell(int32 Idx)
+{
+	if (CellLakeIds[Idx] != INDEX_NONE)
+	{
+		DissolveLake(CellLakeIds[Idx]);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Depression Tree
+// ---------------------------------------------------------------------------
+
+namespace
+{
+	/** Heights closer than this are one flat. */
+	constexpr float BasinFlatEpsilon = KINDA_SMALL_NUMBER;
+
+	int32 FindRoot(TArray<int32>& Parents, int32 I)
+	{
+		while (Parents[I] != I)
+		{
+			Parents[I] = Parents[Parents[I]];
+			I = Parents[I];
+		}
+		return I;
+	}
+
+	/** Shared edge between two leaf basins; water crossing it must first rise to Height. */
+	struct FSpillEdge
+	{
+		float Height;
+		int32 CellA;
+		int32 CellB;
+	};
+}
+
+void UFluidSubsystem::BuildBasins()
+{
+	using namespace FluidConstants;
+
+	bBasinsDirty = false;
+	Basins.Reset();
+	BasinChildren.Reset();
+
+	auto TerrainAt = [this](int32 Idx) { return Grid[Idx].TerrainHeight; };
+
+	// --- Descent: every cell points at its lowest strictly lower neighbour ---
+	TArray<int32> Descent;
+	Descent.Init(INDEX_NONE, TotalCells);
+	TArray<int32> Queue;
+	Queue.Reserve(TotalCells);
+
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			const int32 Idx = FluidGrid::CellIndex(X, Y);
+			float Lowest = TerrainAt(Idx) - BasinFlatEpsilon;
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				const int32 NX = X + NeighborDX[Dir];
+				const int32 NY = Y + NeighborDY[Dir];
+				if (!IsValidCell(NX, NY)) { continue; }
+
+				const int32 NIdx = FluidGrid::CellIndex(NX, NY);
+				if (TerrainAt(NIdx) < Lowest)
+				{
+					Lowest = TerrainAt(NIdx);
+					Descent[Idx] = NIdx;
+				}
+			}
+			if (Descent[Idx] != INDEX_NONE) { Queue.Add(Idx); }
+		}
+	}
+
+	// Flat cells drain toward the nearest edge of their flat that has a way down. Cells still
+	// without a descent afterwards are pit floors.
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const int32 Idx = Queue[Head];
+		const int32 X = FluidGrid::CellX(Idx);
+		const int32 Y = FluidGrid::CellY(Idx);
+		for (int32 Dir = 0; Dir < 4; ++Dir)
+		{
+			const int32 NX = X + NeighborDX[Dir];
+			const int32 NY = Y + NeighborDY[Dir];
+			if (!IsValidCell(NX, NY)) { continue; }
+
+			const int32 NIdx = FluidGrid::CellIndex(NX, NY);
+			if (Descent[NIdx] != INDEX_NONE || FMath::Abs(TerrainAt(NIdx) - TerrainAt(Idx)) > BasinFlatEpsilon) { continue; }
+
+			Descent[NIdx] = Idx;
+			Queue.Add(NIdx);
+		}
+	}
+
+	// --- Leaves: descent trees, with each pit's flat floor merged into one ---
+	TArray<int32> CellRoots;
+	CellRoots.SetNumUninitialized(TotalCells);
+	for (int32 Idx = 0; Idx < TotalCells; ++Idx)
+	{
+		CellRoots[Idx] = Idx;
+	}
+
+	for (int32 Idx = 0; Idx < TotalCells; ++Idx)
+	{
+		if (Descent[Idx] != INDEX_NONE)
+		{
+			CellRoots[FindRoot(CellRoots, Idx)] = FindRoot(CellRoots, Descent[Idx]);
+			continue;
+		}
+
+		const int32 X = FluidGrid::CellX(Idx);
+		const int32 Y = FluidGrid::CellY(Idx);
+		for (int32 Dir = 0; Dir < 4; ++Dir)
+		{
+			const int32 NX = X + NeighborDX[Dir];
+			const int32 NY = Y + NeighborDY[Dir];
+			if (!IsValidCell(NX, NY)) { continue; }
+
+			const int32 NIdx = FluidGrid::CellIndex(NX, NY);
+			if (Descent[NIdx] != INDEX_NONE || FMath::Abs(TerrainAt(NIdx) - TerrainAt(Idx)) > BasinFlatEpsilon) { continue; }
+			CellRoots[FindRoot(CellRoots, Idx)] = FindRoot(CellRoots, NIdx);
+		}
+	}
+
+	TArray<int32> RootToLeaf;
+	RootToLeaf.Init(INDEX_NONE, TotalCells);
+	for (int32 Idx = 0; Idx < TotalCells; ++Idx)
+	{
+		const int32 Root = FindRoot(CellRoots, Idx);
+		if (RootToLeaf[Root] == INDEX_NONE)
+		{
+			RootToLeaf[Root] = Basins.Num();
+			Basins.AddDefaulted_GetRef().PitHeight = TNumericLimits<float>::Max();
+		}
+
+		const int32 Leaf = RootToLeaf[Root];
+		CellBasinIds[Idx] = Leaf;
+		FFluidBasin& Basin = Basins[Leaf];
+		Basin.PitHeight = FMath::Min(Basin.PitHeight, TerrainAt(Idx));
+		++Basin.CellCount;
+	}
+	NumLeafBasins = Basins.Num();
+
+	// Group cells by leaf (counting sort)
+	BasinCellStart.Init(0, NumLeafBasins + 1);
+	for (int32 Leaf = 0; Leaf < NumLeafBasins; ++Leaf)
+	{
+		BasinCellStart[Leaf + 1] = BasinCellStart[Leaf] + Basins[Leaf].CellCount;
+	}
+	TArray<int32> Fill(BasinCellStart);
+	BasinCells.SetNumUninitialized(TotalCells);
+	for (int32 Idx = 0; Idx < TotalCells; ++Idx)
+	{
+		BasinCells[Fill[CellBasinIds[Idx]]++] = Idx;
+	}
+
+	// --- Tree: merge basins across their spill points, lowest first (priority-flood order) ---
+	TArray<FSpillEdge> Edges;
+	for (int32 Y = 0; Y < GridSize; ++Y)
+	{
+		for (int32 X = 0; X < GridSize; ++X)
+		{
+			const int32 Idx = FluidGrid::CellIndex(X, Y);
+			const int32 EastIdx = X + 1 < GridSize ? FluidGrid::CellIndex(X + 1, Y) : INDEX_NONE;
+			const int32 NorthIdx = Y + 1 < GridSize ? FluidGrid::CellIndex(X, Y + 1) : INDEX_NONE;
+			if (EastIdx != INDEX_NONE && CellBasinIds[EastIdx] != CellBasinIds[Idx])
+			{
+				Edges.Add({ FMath::Max(TerrainAt(Idx), TerrainAt(EastIdx)), Idx, EastIdx });
+			}
+			if (NorthIdx != INDEX_NONE && CellBasinIds[NorthIdx] != CellBasinIds[Idx])
+			{
+				Edges.Add({ FMath::Max(TerrainAt(Idx), TerrainAt(NorthIdx)), Idx, NorthIdx });
+			}
+		}
+	}
+	Edges.Sort([](const FSpillEdge& A, const FSpillEdge& B) { return A.Height < B.Height; });
+
+	TArray<int32> NodeRoots;
+	NodeRoots.SetNumUninitialized(NumLeafBasins);
+	for (int32 Leaf = 0; Leaf < NumLeafBasins; ++Leaf)
+	{
+		NodeRoots[Leaf] = Leaf;
+	}
+
+	for (const FSpillEdge& Edge : Edges)
+	{
+		const int32 RootA = FindRoot(NodeRoots, CellBasinIds[Edge.CellA]);
+		const int32 RootB = FindRoot(NodeRoots, CellBasinIds[Edge.CellB]);
+		if (RootA == RootB) { continue; }
+
+		const int32 Merged = Basins.Num();
+		FFluidBasin& Node = Basins.AddDefaulted_GetRef();
+		Node.PitHeight = FMath::Min(Basins[RootA].PitHeight, Basins[RootB].PitHeight);
+		Node.CellCount = Basins[RootA].CellCount + Basins[RootB].CellCount;
+		BasinChildren.Add(FIntPoint(RootA, RootB));
+
+		Basins[RootA].SpillHeight = Edge.Height;
+		Basins[RootA].OutletCell = Edge.CellA;
+		Basins[RootA].Downstream = CellBasinIds[Edge.CellB];
+		Basins[RootA].Parent = Merged;
+
+		Basins[RootB].SpillHeight = Edge.Height;
+		Basins[RootB].OutletCell = Edge.CellB;
+		Basins[RootB].Downstream = CellBasinIds[Edge.CellA];
+		Basins[RootB].Parent = Merged;
+
+		NodeRoots.Add(Merged);
+		NodeRoots[RootA] = Merged;
+		NodeRoots[RootB] = Merged;
+	}
+
+	// Capacity: each cell adds its depth below the spill height of every basin it belongs to
+	for (FFluidBasin& Basin : Basins)
+	{
+		if (Basin.IsRoot())
+		{
+			Basin.SpillHeight = TNumericLimits<float>::Max();
+			Basin.Capacity = TNumericLimits<float>::Max();
+		}
+	}
+	for (int32 Idx = 0; Idx < TotalCells; ++Idx)
+	{
+		const float Terrain = TerrainAt(Idx);
+		for (int32 Node = CellBasinIds[Idx]; Node != INDEX_NONE && !Basins[Node].IsRoot(); Node = Basins[Node].Parent)
+		{
+			Basins[Node].Capacity += FMath::Max(0.f, Basins[Node].SpillHeight - Terrain);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FluidSubsystem: depression tree built, %d pits, %d basins"), NumLeafBasins, Basins.Num());
+}
+
+int32 UFluidSubsystem::GetBasinAtWorldPos(FVector WorldPos) const
+{
+	const FIntPoint Cell = WorldToCell(WorldPos);
+	if (!IsValidCell(Cell.X, Cell.Y) || Basins.Num() == 0) { return INDEX_NONE; }
+	return CellBasinIds[GetCellIndex(Cell.X, Cell.Y)];
+}
+
+bool UFluidSubsystem::GetBasinInfo(int32 BasinId, FFluidBasin& OutBasin) const
+{
+	if (!Basins.IsValidIndex(BasinId)) { return false; }
+	OutBasin = Basins[BasinId];
+	return true;
+}
+
+void UFluidSubsystem::GetBasinCells(int32 BasinId, TArray<int32>& OutCells) const
+{
+	if (!Basins.IsValidIndex(BasinId)) { return; }
+
+	TArray<int32, TInlineAllocator<32>> Stack;
+	Stack.Add(BasinId);
+	while (Stack.Num() > 0)
+	{
+		const int32 Node = Stack.Pop(EAllowShrinking::No);
+		if (Node < NumLeafBasins)
+		{
+			OutCells.Append(&BasinCells[BasinCellStart[Node]], BasinCellStart[Node + 1] - BasinCellStart[Node]);
+			continue;
+		}
+
+		const FIntPoint& Children = BasinChildren[Node - NumLeafBasins];
+		Stack.Add(Children.X);
+		Stack.Add(Children.Y);
+	}
+}
+
+float UFluidSubsystem::GetBasinVolume(int32 BasinId) const
+{
+	TArray<int32> Cells;
+	GetBasinCells(BasinId, Cells);
+
+	float Volume = 0.f;
+	for (const int32 Idx : Cells)
+	{
+		Volume += Grid[Idx].FluidVolume;
+	}
+	return Volume;
+}
+
+float UFluidSubsystem::EstimateBasinFillSeconds(int32 BasinId, float InflowPerSecond) const
+{
+	if (!Basins.IsValidIndex(BasinId) || Basins[BasinId].IsRoot() || InflowPerSecond <= 0.f) { return -1.f; }
+
+	const float Remaining = Basins[BasinId].Capacity - GetBasinVolume(BasinId);
+	return FMath::Max(0.f, Remaining) / InflowPerSecond;
+}
+
+// ---------------------------------------------------------------------------
+// Region Handles
+// ---------------------------------------------------------------------------
+
+void UFluidSubsystem::BuildRegion(FVector Center, float Radius, FFluidRegion& OutRegion) const
+{
+	const FIntPoint CenterCell = WorldToCell(Center);
+	const int32 CellRadius = FMath::CeilToInt(Radius / CellWorldSize);
+
+	OutRegion.Cells.Reset();
+	OutRegion.Falloff.Reset();
+	OutRegion.Directions.Reset();
+	OutRegion.CellRect = FIntRect(CenterCell - FIntPoint(CellRadius), CenterCell + FIntPoint(CellRadius));
+
+	for (int32 DY = -CellRadius; DY <= CellRadius; ++DY)
+	{
+		for (int32 DX = -CellRadius; DX <= CellRadius; ++DX)
+		{
+			const int32 X = CenterCell.X + DX;
+			const int32 Y = CenterCell.Y + DY;
+			if (!IsValidCell(X, Y)) { continue; }
+
+			const FVector CellPos = CellToWorld(X, Y);
+			const FVector2D Offset(CellPos.X - Center.X, CellPos.Y - Center.Y);
+			const float Dist = Offset.Size();
+			if (Dist > Radius) { continue; }
+
+			OutRegion.Cells.Add(GetCellIndex(X, Y));
+			OutRegion.Falloff.Add(Radius > 0.f ? 1.f - (Dist / Radius) : 1.f);
+			OutRegion.Directions.Add(Dist < KINDA_SMALL_NUMBER ? FVector2D::ZeroVector : Offset / Dist);
+		}
+	}
+}
+
+void UFluidSubsystem::GetCellsInRadius(FVector Center, float Radius, TArray<int32>& OutCells) const
+{
+	FFluidRegion Region;
+	BuildRegion(Center, Radius, Region);
+	OutCells = MoveTemp(Region.Cells);
+}
+
+FFluidRegionHandle UFluidSubsystem::RegisterRegion(FVector Center, float Radius)
+{
+	FFluidRegion Region;
+	BuildRegion(Center, Radius, Region);
+	Region.Serial = NextRegionSerial++;
+
+	FFluidRegionHandle Handle;
+	Handle.Serial = Region.Serial;
+	Handle.Index = Regions.Add(MoveTemp(Region));
+	return Handle;
+}
+
+void UFluidSubsystem::ReleaseRegion(FFluidRegionHandle& Handle)
+{
+	if (FindRegion(Handle))
+	{
+		Regions.RemoveAt(Handle.Index);
+	}
+	Handle = FFluidRegionHandle();
+}
+
+const FFluidRegion* UFluidSubsystem::FindRegion(const FFluidRegionHandle& Handle) const
+{
+	if (!Regions.IsValidIndex(Handle.Index)) { return nullptr; }
+	const FFluidRegion& Region = Regions[Handle.Index];
+	return Region.Serial == Handle.Serial ? &Region : nullptr;
+}
+
+float UFluidSubsystem::RemoveFluidInRegion(const FFluidRegionHandle& Handle, float Amount)
+{
+	const FFluidRegion* Region = FindRegion(Handle);
+	return Region ? RemoveFluidInCells(*Region, Amount) : 0.f;
+}
+
+void UFluidSubsystem::ApplyForceInRegion(const FFluidRegionHandle& Handle, FVector2D Force)
+{
+	if (const FFluidRegion* Region = FindRegion(Handle)) { ApplyForceInCells(*Region, Force); }
+}
+
+void UFluidSubsystem::ApplyRadialForceInRegion(const FFluidRegionHandle& Handle, float Strength)
+{
+	if (const FFluidRegion* Region = FindRegion(Handle)) { ApplyRadialForceInCells(*Region, Strength); }
+}
+
+void UFluidSubsystem::SetFrozenInRegion(const FFluidRegionHandle& Handle, bool bFreeze)
+{
+	if (const FFluidRegion* Region = FindRegion(Handle)) { SetFrozenInCells(*Region, bFreeze); }
+}
+
+float UFluidSubsystem::RemoveFluidInCells(const FFluidRegion& Region, float Amount)
+{
+	if (Amount <= 0.f) { return 0.f; }
+
+	float TotalVolume = 0.f;
+	for (const int32 Idx : Region.Cells)
+	{
+		TotalVolume += Grid[Idx].FluidVolume;
+	}
+
+	if (TotalVolume <= 0.f) { return 0.f; }
+
+	// Proportional removal: deeper cells lose more volume. This gives a natural
+	// "draining the deepest part first" feel for evaporators and the heat lance.
+	const float RemoveFraction = FMath::Min(Amount / TotalVolume, 1.f);
+	float Removed = 0.f;
+	for (const int32 Idx : Region.Cells)
+	{
+		const float Before = Grid[Idx].FluidVolume;
+		Grid[Idx].FluidVolume = FMath::Max(0.f, Before * (1.f - RemoveFraction));
+		Removed += Before - Grid[Idx].FluidVolume;
+		NoteHeldCellWrite(Idx, Grid[Idx].FluidVolume - Before);
+	}
+
+	WakeCellsInRect(Region.CellRect.Min.X, Region.CellRect.Min.Y, Region.CellRect.Max.X, Region.CellRect.Max.Y);
+	return Removed;
+}
+
+void UFluidSubsystem::ApplyForceInCells(const FFluidRegion& Region, FVector2D Force)
+{
+	for (int32 I = 0; I < Region.Cells.Num(); ++I)
+	{
+		FFluidCell& Cell = Grid[Region.Cells[I]];
+		if (Cell.FluidVolume <= KINDA_SMALL_NUMBER) { continue; }
+		Cell.FlowVelocity += Force * Region.Falloff[I];
+	}
+
+	WakeCellsInRect(Region.CellRect.Min.X, Region.CellRect.Min.Y, Region.CellRect.Max.X, Region.CellRect.Max.Y);
+}
+
+void UFluidSubsystem::ApplyRadialForceInCells(const FFluidRegion& Region, float Strength)
+{
+	for (int32 I = 0; I < Region.Cells.Num(); ++I)
+	{
+		FFluidCell& Cell = Grid[Region.Cells[I]];
+		if (Cell.FluidVolume <= KINDA_SMALL_NUMBER) { continue; }
+		Cell.FlowVelocity += Region.Directions[I] * Strength * Region.Falloff[I];
+	}
+
+	WakeCellsInRect(Region.CellRect.Min.X, Region.CellRect.Min.Y, Region.CellRect.Max.X, Region.CellRect.Max.Y);
+}
+
+void UFluidSubsystem::SetFrozenInCells(const FFluidRegion& Region, bool bFreeze)
+{
+	for (const int32 Idx : Region.Cells)
+	{
+		if (Grid[Idx].bFrozen == bFreeze) { continue; }
+		DissolveLakeAtCell(Idx);
+		Grid[Idx].bFrozen = bFreeze;
+
+		uint16& Count = TileFrozenCounts[FluidGrid::TileOfCell(Idx)];
+		Count = bFreeze ? Count + 1 : Count - 1;
+	}
+
+	WakeCellsInRect(Region.CellRect.Min.X, Region.CellRect.Min.Y, Region.CellRect.Max.X, Region.CellRect.Max.Y);
+}
+
+// ---------------------------------------------------------------------------
+// Coalesced Effects
+// ---------------------------------------------------------------------------
+
+int32 UFluidSubsystem::RegisterEffectContributor()
+{
+	return ContributorRemoved.Add(0.f);
+}
+
+void UFluidSubsystem::ReleaseEffectContributor(int32 ContributorId)
+{
+	// The slot stays allocated until queued removals resolve, so a new tower can't inherit their credit
+	if (ContributorRemoved.IsValidIndex(ContributorId))
+	{
+		ReleasedContributors.AddUnique(ContributorId);
+	}
+}
+
+float UFluidSubsystem::ConsumeRemovedVolume(int32 ContributorId)
+{
+	if (!ContributorRemoved.IsValidIndex(ContributorId)) { return 0.f; }
+	return TExchange(ContributorRemoved[ContributorId], 0.f);
+}
+
+void UFluidSubsystem::MarkEffectCell(int32 Idx)
+{
+	if (EffectCellMask[Idx]) { return; }
+	EffectCellMask[Idx] = true;
+	EffectCells.Add(Idx);
+}
+
+void UFluidSubsystem::QueueRemovalInCells(TConstArrayView<int32> Cells, const FIntRect& CellRect, float Amount, int32 ContributorId)
+{
+	if (Amount <= 0.f || Cells.Num() == 0) { return; }
+
+	FRemovalRequest& Request = RemovalRequests.AddDefaulted_GetRef();
+	Request.CellStart = RemovalRequestCells.Num();
+	Request.CellCount = Cells.Num();
+	Request.Amount = Amount;
+	Request.ContributorId = ContributorId;
+	RemovalRequestCells.Append(Cells.GetData(), Cells.Num());
+
+	WakeCellsInRect(CellRect.Min.X, CellRect.Min.Y, CellRect.Max.X, CellRect.Max.Y);
+}
+
+void UFluidSubsystem::QueueRemoveFluidInRegion(const FFluidRegionHandle& Handle, float Amount, int32 ContributorId)
+{
+	if (const FFluidRegion* Region = FindRegion(Handle))
+	{
+		QueueRemovalInCells(Region->Cells, Region->CellRect, Amount, ContributorId);
+	}
+}
+
+void UFluidSubsystem::QueueRemoveFluidInRadius(FVector WorldPos, float Radius, float Amount, int32 ContributorId)
+{
+	FFluidRegion Region;
+	BuildRegion(WorldPos, Radius, Region);
+	QueueRemovalInCells(Region.Cells, Region.CellRect, Amount, ContributorId);
+}
+
+void UFluidSubsystem::QueueForceInRegion(const FFluidRegionHandle& Handle, FVector2D Force)
+{
+	const FFluidRegion* Region = FindRegion(Handle);
+	if (!Region) { return; }
+
+	for (int32 I = 0; I < Region->Cells.Num(); ++I)
+	{
+		const int32 Idx = Region->Cells[I];
+		ForcePlane[Idx] += Force * Region->Falloff[I];
+		MarkEffectCell(Idx);
+	}
+
+	WakeCellsInRect(Region->CellRect.Min.X, Region->CellRect.Min.Y, Region->CellRect.Max.X, Region->CellRect.Max.Y);
+}
+
+void UFluidSubsystem::QueueRadialForceInRegion(const FFluidRegionHandle& Handle, float Strength)
+{
+	const FFluidRegion* Region = FindRegion(Handle);
+	if (!Region) { return; }
+
+	for (int32 I = 0; I < Region->Cells.Num(); ++I)
+	{
+		const int32 Idx = Region->Cells[I];
+		ForcePlane[Idx] += Region->Directions[I] * Strength * Region->Falloff[I];
+		MarkEffectCell(Idx);
+	}
+
+	WakeCellsInRect(Region->CellRect.Min.X, Region->CellRect.Min.Y, Region->CellRect.Max.X, Region->CellRect.Max.Y);
+}
+
+void UFluidSubsystem::QueueInflowAtCell(int32 X, int32 Y, float Amount)
+{
+	if (!IsValidCell(X, Y) || Amount <= 0.f) { return; }
+
+	const int32 Idx = GetCellIndex(X, Y);
+	InflowPlane[Idx] += Amount;
+	MarkEffectCell(Idx);
+	WakeCell(X, Y);
+}
+
+void UFluidSubsystem::ResolveEffects()
+{
+	// --- Expand removals into per-cell asks against the volume at the start of this step ---
+	// Each request keeps RemoveFluidInRadius semantics (proportional to depth within its footprint).
+	RemovalRequestAsks.SetNumUninitialized(RemovalRequestCells.Num(), EAllowShrinking::No);
+
+	for (const FRemovalRequest& Request : RemovalRequests)
+	{
+		float TotalVolume = 0.f;
+		for (int32 K = Request.CellStart; K < Request.CellStart + Request.CellCount; ++K)
+		{
+			TotalVolume += Grid[RemovalRequestCells[K]].FluidVolume;
+		}
+
+		const float Fraction = TotalVolume > 0.f ? FMath::Min(Request.Amount / TotalVolume, 1.f) : 0.f;
+		for (int32 K = Request.CellStart; K < Request.CellStart + Request.CellCount; ++K)
+		{
+			const int32 Idx = RemovalRequestCells[K];
+			const float Ask = Grid[Idx].FluidVolume * Fraction;
+			RemovalRequestAsks[K] = Ask;
+			if (Ask <= 0.f) { continue; }
+			RemovalPlane[Idx] += Ask;
+			MarkEffectCell(Idx);
+		}
+	}
+
+	// --- Fused pass: one visit per touched cell, planes cleared as they are consumed ---
+	for (const int32 Idx : EffectCells)
+	{
+		FFluidCell& Cell = Grid[Idx];
+
+		// Overlapping asks that exceed the cell are granted proportionally; the granted
+		// fraction stays in RemovalPlane for crediting below.
+		const float Asked = RemovalPlane[Idx];
+		const float Granted = FMath::Min(Asked, Cell.FluidVolume);
+		RemovalPlane[Idx] = Asked > 0.f ? Granted / Asked : 0.f;
+
+		const float Before = Cell.FluidVolume;
+		Cell.FluidVolume = FMath::Max(0.f, Cell.FluidVolume - Granted) + InflowPlane[Idx];
+		NoteHeldCellWrite(Idx, Cell.FluidVolume - Before);
+		if (Cell.FluidVolume > KINDA_SMALL_NUMBER)
+		{
+			Cell.FlowVelocity += ForcePlane[Idx];
+		}
+
+		InflowPlane[Idx] = 0.f;
+		ForcePlane[Idx] = FVector2D::ZeroVector;
+		EffectCellMask[Idx] = false;
+	}
+
+	// --- Credit each contributor with its share of what was granted ---
+	for (const FRemovalRequest& Request : RemovalRequests)
+	{
+		if (!ContributorRemoved.IsValidIndex(Request.ContributorId)) { continue; }
+		if (ReleasedContributors.Contains(Request.ContributorId)) { continue; }
+
+		float Credited = 0.f;
+		for (int32 K = Request.CellStart; K < Request.CellStart + Request.CellCount; ++K)
+		{
+			Credited += RemovalRequestAsks[K] * RemovalPlane[RemovalRequestCells[K]];
+		}
+		ContributorRemoved[Request.ContributorId] += Credited;
+	}
+
+	for (const int32 Idx : EffectCells)
+	{
+		RemovalPlane[Idx] = 0.f;
+	}
+
+	for (const int32 ContributorId : ReleasedContributors)
+	{
+		ContributorRemoved.RemoveAt(ContributorId);
+	}
+	ReleasedContributors.Reset();
+
+	EffectCells.Reset();
+	RemovalRequests.Reset();
+	RemovalRequestCells.Reset();
+}
+
+// ---------------------------------------------------------------------------
+// Inflow Boundaries
+// ---------------------------------------------------------------------------
+
+int32 UFluidSubsystem::RegisterInflow(FVector Center, float Radius, float RatePerSecond, const UCurveFloat* Schedule)
+{
+	FFluidInflow Inflow;
+	BuildInflowFootprint(Center, Radius, Inflow);
+	Inflow.RatePerSecond = FMath::Max(0.f, RatePerSecond);
+	Inflow.Schedule = Schedule;
+	return Inflows.Add(MoveTemp(Inflow));
+}
+
+void UFluidSubsystem::BuildInflowFootprint(FVector Center, float Radius, FFluidInflow& OutInflow) const
+{
+	FFluidRegion Region;
+	BuildRegion(Center, Radius, Region);
+
+	// Small radii can miss every cell centre; fall back to the cell under Center
+	if (Region.Cells.Num() == 0)
+	{
+		const FIntPoint Cell = WorldToCell(Center);
+		if (IsValidCell(Cell.X, Cell.Y))
+		{
+			OutInflow.Cells.Add(GetCellIndex(Cell.X, Cell.Y));
+			OutInflow.Weights.Add(1.f);
+			OutInflow.CellRect = FIntRect(Cell, Cell);
+		}
+	}
+	else
+	{
+		// Falloff-weighted so the centre receives the most; +1 keeps rim cells from getting nothing
+		float WeightSum = 0.f;
+		for (const float Falloff : Region.Falloff)
+		{
+			WeightSum += Falloff + 1.f;
+		}
+		OutInflow.Cells = MoveTemp(Region.Cells);
+		OutInflow.Weights.Reserve(OutInflow.Cells.Num());
+		for (const float Falloff : Region.Falloff)
+		{
+			OutInflow.Weights.Add((Falloff + 1.f) / WeightSum);
+		}
+		OutInflow.CellRect = Region.CellRect;
+	}
+}
+
+void UFluidSubsystem::SetInflowRate(int32 InflowId, float RatePerSecond)
 {
-	UWorld* World = GetWorld();
-	if (!World) { return; }
+	if (Inflows.IsValidIndex(InflowId))
+	{
+		Inflows[InflowId].RatePerSecond = FMath::Max(0.f, RatePerSecond);
+	}
+}
 
-	FCollisionQueryParams Params(SCENE_QUERY_STAT(FluidTerrainBake), /*bTraceComplex=*/false);
-	const float TraceStartZ = 100000.f;
-	const float TraceEndZ = -100000.f;
+void UFluidSubsystem::ReleaseInflow(int32 InflowId)
+{
+	if (Inflows.IsValidIndex(InflowId))
+	{
+		Inflows.RemoveAt(InflowId);
+	}
+}
 
-	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+void UFluidSubsystem::ApplyInflows()
+{
+	for (FFluidInflow& Inflow : Inflows)
 	{
-		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		float Rate = Inflow.RatePerSecond;
+		if (const UCurveFloat* Schedule = Inflow.Schedule.Get())
 		{
-			const FVector CellCenter = CellToWorld(X, Y);
-			const FVector Start(CellCenter.X, CellCenter.Y, TraceStartZ);
-			const FVector End(CellCenter.X, CellCenter.Y, TraceEndZ);
+			Rate *= FMath::Max(0.f, Schedule->GetFloatValue(Inflow.ElapsedSeconds));
+		}
+		Inflow.ElapsedSeconds += SimStepRate;
 
-			FHitResult Hit;
-			const bool bHit = World->LineTraceSingleByChannel(
-				Hit, Start, End,
-				ECC_WorldStatic,
-				Params
-			);
+		const float StepVolume = Rate * SimStepRate;
+		if (StepVolume <= 0.f || Inflow.Cells.Num() == 0) { continue; }
 
-			Grid[GetCellIndex(X, Y)].TerrainHeight = bHit ? Hit.ImpactPoint.Z : 0.f;
+		for (int32 I = 0; I < Inflow.Cells.Num(); ++I)
+		{
+			const int32 Idx = Inflow.Cells[I];
+			InflowPlane[Idx] += StepVolume * Inflow.Weights[I];
+			MarkEffectCell(Idx);
 		}
+
+		WakeCellsInRect(Inflow.CellRect.Min.X, Inflow.CellRect.Min.Y, Inflow.CellRect.Max.X, Inflow.CellRect.Max.Y);
 	}
 }
 
 // ---------------------------------------------------------------------------
-// Flow Simulation — Accumulator Pattern
+// Threshold Watches
 // ---------------------------------------------------------------------------
 
-void UFluidSubsystem::SimStep()
+int32 UFluidSubsystem::AddFluidWatch(const FFluidWatchDesc& Desc, FOnFluidWatchEvent OnEvent)
 {
-	// Clear accumulators
-	FMemory::Memzero(FluidDeltas.GetData(), FluidDeltas.Num() * sizeof(float));
-	FMemory::Memzero(FlowVelocityDeltas.GetData(), FlowVelocityDeltas.Num() * sizeof(FVector2D));
+	FFluidWatch Watch;
+	Watch.Desc = Desc;
+	Watch.OnEvent = OnEvent;
 
-	// Cardinal neighbor offsets
-	static const int32 DX[4] = { 1, -1, 0,  0 };
-	static const int32 DY[4] = { 0,  0, 1, -1 };
+	if (Desc.Shape == EFluidWatchShape::Grid)
+	{
+		Watch.TileRect = FIntRect(0, 0, FluidConstants::TilesPerSide - 1, FluidConstants::TilesPerSide - 1);
+	}
+	else if (Desc.Shape == EFluidWatchShape::Basin)
+	{
+		// Cells are resolved once; a later rebake does not move them to the rebuilt tree
+		const int32 BasinId = Desc.BasinId != INDEX_NONE ? Desc.BasinId : GetBasinAtWorldPos(Desc.Center);
+		GetBasinCells(BasinId, Watch.Cells);
 
-	// Direction vectors for velocity computation (matches DX/DY order)
-	static const FVector2D DirVec[4] = {
-		FVector2D(1.f, 0.f),   // +X (East)
-		FVector2D(-1.f, 0.f),  // -X (West)
-		FVector2D(0.f, 1.f),   // +Y (North)
-		FVector2D(0.f, -1.f)   // -Y (South)
-	};
+		FIntPoint MinCell(MAX_int32, MAX_int32);
+		FIntPoint MaxCell(MIN_int32, MIN_int32);
+		for (const int32 Idx : Watch.Cells)
+		{
+			const FIntPoint Cell = FluidGrid::CellCoord(Idx);
+			MinCell = MinCell.ComponentMin(Cell);
+			MaxCell = MaxCell.ComponentMax(Cell);
+		}
 
-	// --- Pass 1: Compute transfers, accumulate deltas ---
-	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+		if (Watch.Cells.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FluidSubsystem: basin watch %d at %s covers no cells"), BasinId, *Desc.Center.ToString());
+		}
+		else
+		{
+			Watch.TileRect = FIntRect(MinCell / FluidConstants::TileSize, MaxCell / FluidConstants::TileSize);
+		}
+	}
+	else
 	{
-		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		// Resolve the footprint once; the sweep then only reads cell indices
+		const FIntPoint CenterCell = WorldToCell(Desc.Center);
+		FIntPoint CellRadius(0, 0);
+		if (Desc.Shape == EFluidWatchShape::Circle)
+		{
+			CellRadius = FIntPoint(FMath::CeilToInt(Desc.Radius / CellWorldSize));
+		}
+		else if (Desc.Shape == EFluidWatchShape::Rect)
 		{
-			const int32 Idx = GetCellIndex(X, Y);
-			const FFluidCell& Cell = Grid[Idx];
+			CellRadius = FIntPoint(FMath::CeilToInt(Desc.HalfExtent.X / CellWorldSize), FMath::CeilToInt(Desc.HalfExtent.Y / CellWorldSize));
+		}
 
-			if (Cell.bFrozen || Cell.bBlocked) { continue; }
-			if (Cell.FluidVolume <= KINDA_SMALL_NUMBER) { continue; }
+		FIntPoint MinCell(MAX_int32, MAX_int32);
+		FIntPoint MaxCell(MIN_int32, MIN_int32);
 
-			const float CellSurface = Cell.GetSurfaceHeight();
-			const float CurrentVolume = Cell.FluidVolume;
+		for (int32 DY = -CellRadius.Y; DY <= CellRadius.Y; ++DY)
+		{
+			for (int32 DX = -CellRadius.X; DX <= CellRadius.X; ++DX)
+			{
+				const int32 X = CenterCell.X + DX;
+				const int32 Y = CenterCell.Y + DY;
+				if (!IsValidCell(X, Y)) { continue; }
+
+				const FVector CellPos = CellToWorld(X, Y);
+				if (Desc.Shape == EFluidWatchShape::Circle
+					&& FVector2D::Distance(FVector2D(Desc.Center), FVector2D(CellPos)) > Desc.Radius) { continue; }
+				if (Desc.Shape == EFluidWatchShape::Rect
+					&& (FMath::Abs(CellPos.X - Desc.Center.X) > Desc.HalfExtent.X || FMath::Abs(CellPos.Y - Desc.Center.Y) > Desc.HalfExtent.Y)) { continue; }
+
+				Watch.Cells.Add(GetCellIndex(X, Y));
+				MinCell = MinCell.ComponentMin(FIntPoint(X, Y));
+				MaxCell = MaxCell.ComponentMax(FIntPoint(X, Y));
+			}
+		}
 
-			float TotalOutflow = 0.f;
-			float NeighborTransfer[4] = {};
+		if (Watch.Cells.Num() == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FluidSubsystem: fluid watch at %s covers no cells"), *Desc.Center.ToString());
+		}
+		else
+		{
+			Watch.TileRect = FIntRect(MinCell / FluidConstants::TileSize, MaxCell / FluidConstants::TileSize);
+		}
+	}
 
-			for (int32 Dir = 0; Dir < 4; ++Dir)
+	const int32 WatchId = NextWatchId++;
+	Watches.Add(WatchId, MoveTemp(Watch));
+	return WatchId;
+}
+
+void UFluidSubsystem::RemoveFluidWatch(int32 WatchId)
+{
+	Watches.Remove(WatchId);
+}
+
+float UFluidSubsystem::ComputeWatchMetric(const FFluidWatch& Watch) const
+{
+	if (Watch.Desc.Shape == EFluidWatchShape::Grid)
+	{
+		if (Watch.Desc.Metric == EFluidWatchMetric::TotalVolume)
+		{
+			float Total = 0.f;
+			for (const float TileVolume : TileVolumes)
 			{
-				const int32 NX = X + DX[Dir];
-				const int32 NY = Y + DY[Dir];
-				if (!IsValidCell(NX, NY)) { continue; }
+				Total += TileVolume;
+			}
+			return Total;
+		}
 
-				const int32 NIdx = GetCellIndex(NX, NY);
-				const FFluidCell& Neighbor = Grid[NIdx];
+		float Max = 0.f;
+		for (const FFluidCell& Cell : Grid)
+		{
+			Max = FMath::Max(Max, Watch.Desc.Metric == EFluidWatchMetric::MaxDepth ? Cell.FluidVolume : Cell.GetSurfaceHeight());
+		}
+		return Max;
+	}
 
-				if (Neighbor.bBlocked) { continue; }
+	switch (Watch.Desc.Metric)
+	{
+	case EFluidWatchMetric::TotalVolume:
+	{
+		float Total = 0.f;
+		for (const int32 Idx : Watch.Cells) { Total += Grid[Idx].FluidVolume; }
+		return Total;
+	}
+	case EFluidWatchMetric::MaxSurfaceHeight:
+	{
+		float Max = Watch.Cells.Num() > 0 ? TNumericLimits<float>::Lowest() : 0.f;
+		for (const int32 Idx : Watch.Cells) { Max = FMath::Max(Max, Grid[Idx].GetSurfaceHeight()); }
+		return Max;
+	}
+	case EFluidWatchMetric::MaxDepth:
+	default:
+	{
+		float Max = 0.f;
+		for (const int32 Idx : Watch.Cells) { Max = FMath::Max(Max, Grid[Idx].FluidVolume); }
+		return Max;
+	}
+	}
+}
 
-				const float Delta = CellSurface - Neighbor.GetSurfaceHeight();
-				if (Delta <= 0.f) { continue; }
+void UFluidSubsystem::EvaluateWatches()
+{
+	if (Watches.Num() == 0) { return; }
 
-				float Transfer = Delta * FlowRate;
-				Transfer = FMath::Min(Transfer, Delta * OscillationClamp);
+	struct FPendingEvent
+	{
+		int32 WatchId;
+		bool bAbove;
+		float Value;
+	};
+	TArray<FPendingEvent, TInlineAllocator<16>> Pending;
 
-				NeighborTransfer[Dir] = Transfer;
-				TotalOutflow += Transfer;
-			}
+	for (TPair<int32, FFluidWatch>& Pair : Watches)
+	{
+		FFluidWatch& Watch = Pair.Value;
 
-			// Scale back if total outflow exceeds available volume
-			if (TotalOutflow > CurrentVolume && TotalOutflow > KINDA_SMALL_NUMBER)
+		// Nothing under a watch changes unless one of its tiles was stepped
+		bool bTouched = false;
+		for (int32 TY = Watch.TileRect.Min.Y; TY <= Watch.TileRect.Max.Y && !bTouched; ++TY)
+		{
+			for (int32 TX = Watch.TileRect.Min.X; TX <= Watch.TileRect.Max.X; ++TX)
 			{
-				const float Scale = CurrentVolume / TotalOutflow;
-				for (int32 Dir = 0; Dir < 4; ++Dir)
-				{
-					NeighborTransfer[Dir] *= Scale;
-				}
-				TotalOutflow = CurrentVolume;
+				if (StepTiles[TY * FluidConstants::TilesPerSide + TX]) { bTouched = true; break; }
 			}
+		}
+		if (!bTouched && !Watch.bNeedsEvaluation && !(Watch.bAbove && Watch.Desc.bReportWhileAbove)) { continue; }
+		Watch.bNeedsEvaluation = false;
 
-			// Accumulate
-			FluidDeltas[Idx] -= TotalOutflow;
+		const float Value = ComputeWatchMetric(Watch);
+		const bool bWasAbove = Watch.bAbove;
 
-			for (int32 Dir = 0; Dir < 4; ++Dir)
-			{
-				if (NeighborTransfer[Dir] <= 0.f) { continue; }
-				const int32 NX = X + DX[Dir];
-				const int32 NY = Y + DY[Dir];
-				FluidDeltas[GetCellIndex(NX, NY)] += NeighborTransfer[Dir];
-				FlowVelocityDeltas[Idx] += DirVec[Dir] * NeighborTransfer[Dir];
-			}
+		if (!bWasAbove && Value >= Watch.Desc.Threshold)
+		{
+			Watch.bAbove = true;
+		}
+		else if (bWasAbove && Value < Watch.Desc.Threshold - Watch.Desc.Hysteresis)
+		{
+			Watch.bAbove = false;
+		}
+
+		if (Watch.bAbove != bWasAbove || (Watch.bAbove && Watch.Desc.bReportWhileAbove))
+		{
+			Pending.Add({ Pair.Key, Watch.bAbove, Value });
 		}
 	}
 
-	// --- Pass 2: Apply deltas ---
-	for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
+	// Fire after the sweep: handlers are free to add or remove watches
+	for (const FPendingEvent& Event : Pending)
 	{
-		Grid[I].FluidVolume = FMath::Max(0.f, Grid[I].FluidVolume + FluidDeltas[I]);
-		// Derive FlowVelocity: damp existing + add new outflow direction
-		Grid[I].FlowVelocity = Grid[I].FlowVelocity * VelocityDamping + FlowVelocityDeltas[I];
+		if (const FFluidWatch* Watch = Watches.Find(Event.WatchId))
+		{
+			FOnFluidWatchEvent Callback = Watch->OnEvent;
+			Callback.ExecuteIfBound(Event.WatchId, Event.bAbove, Event.Value);
+		}
 	}
+}
 
-	// Push grid data to render targets for the surface renderer
-	UpdateRenderTargets();
+void UFluidSubsystem::WakeCellsInRect(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY)
+{
+	const int32 MinTX = FMath::Clamp(MinX - 1, 0, FluidConstants::GridSize - 1) / FluidConstants::TileSize;
+	const int32 MinTY = FMath::Clamp(MinY - 1, 0, FluidConstants::GridSize - 1) / FluidConstants::TileSize;
+	const int32 MaxTX = FMath::Clamp(MaxX + 1, 0, FluidConstants::GridSize - 1) / FluidConstants::TileSize;
+	const int32 MaxTY = FMath::Clamp(MaxY + 1, 0, FluidConstants::GridSize - 1) / FluidConstants::TileSize;
 
-	// Debug draw
-	if (bDebugDraw || (CVarDebugDraw && CVarDebugDraw->GetInt() != 0))
+	for (int32 TY = MinTY; TY <= MaxTY; ++TY)
 	{
-		DrawDebugFluid();
+		for (int32 TX = MinTX; TX <= MaxTX; ++TX)
+		{
+			AwakeTiles[TY * FluidConstants::TilesPerSide + TX] = true;
+		}
 	}
 }
 
@@ -200,42 +2167,181 @@ void UFluidSubsystem::SimStep()
 // Debug Visualization
 // ---------------------------------------------------------------------------
 
-void UFluidSubsystem::DrawDebugFluid() const
+bool UFluidSubsystem::IsDebugDrawEnabled() const
+{
+	return bDebugDraw || (CVarDebugDraw && CVarDebugDraw->GetInt() != 0);
+}
+
+EFluidDebugMode UFluidSubsystem::GetActiveDebugMode() const
+{
+	const int32 CVarMode = CVarDebugDrawMode ? CVarDebugDrawMode->GetInt() : -1;
+	if (CVarMode < 0) { return DebugDrawMode; }
+	return static_cast<EFluidDebugMode>(FMath::Min(CVarMode, static_cast<int32>(EFluidDebugMode::Basins)));
+}
+
+void UFluidSubsystem::UpdateDebugView()
 {
 	UWorld* World = GetWorld();
 	if (!World) { return; }
 
+	// Lazily create a transient host actor for the debug mesh
+	if (!DebugComponent)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		AActor* Host = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!Host) { return; }
+
+		DebugComponent = NewObject<UFluidDebugComponent>(Host, TEXT("FluidDebugView"));
+		Host->SetRootComponent(DebugComponent);
+		DebugComponent->RegisterComponent();
+
+		const float GridExtent = FluidConstants::GridSize * CellWorldSize;
+		DebugComponent->SetDrawBounds(FBox(
+			FVector(GridWorldOrigin.X, GridWorldOrigin.Y, -FluidConstants::TerrainTraceHalfHeight),
+			FVector(GridWorldOrigin.X + GridExtent, GridWorldOrigin.Y + GridExtent, FluidConstants::TerrainTraceHalfHeight)));
+	}
+
+	if (!DebugComponent->IsVisible())
+	{
+		DebugComponent->SetVisibility(true);
+	}
+
 	static const float MaxDepth = 300.f;
+	static const float MaxFlow = FluidConstants::FlowEncodeRange;
+	static const float MaxStepCost = 5.f;
+	const float CellHalfExtent = CellWorldSize * 0.45f;
+	const EFluidDebugMode Mode = GetActiveDebugMode();
 
-	for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+	TArray<FFluidDebugQuad> Quads;
+
+	if (Mode == EFluidDebugMode::ActiveTiles)
 	{
-		for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+		// One quad per awake or wet tile, drawn at the tile's highest surface.
+		// Awake tiles are green (brighter = fuller), sleeping wet tiles are grey.
+		Quads.Reserve(FluidConstants::TotalTiles);
+		const float TileHalfExtent = FluidConstants::TileSize * CellWorldSize * 0.48f;
+
+		for (int32 TY = 0; TY < FluidConstants::TilesPerSide; ++TY)
 		{
-			const FFluidCell& Cell = Grid[GetCellIndex(X, Y)];
-			if (Cell.FluidVolume < KINDA_SMALL_NUMBER) { continue; }
+			for (int32 TX = 0; TX < FluidConstants::TilesPerSide; ++TX)
+			{
+				float MaxSurface = -BIG_NUMBER;
+				int32 WetCells = 0;
+
+				for (int32 Y = TY * FluidConstants::TileSize; Y < (TY + 1) * FluidConstants::TileSize; ++Y)
+				{
+					for (int32 X = TX * FluidConstants::TileSize; X < (TX + 1) * FluidConstants::TileSize; ++X)
+					{
+						const FFluidCell& Cell = Grid[GetCellIndex(X, Y)];
+						if (Cell.FluidVolume < KINDA_SMALL_NUMBER) { continue; }
+						++WetCells;
+						MaxSurface = FMath::Max(MaxSurface, Cell.GetSurfaceHeight());
+					}
+				}
 
-			const float T = FMath::Clamp(Cell.FluidVolume / MaxDepth, 0.f, 1.f);
-			const uint8 R = static_cast<uint8>(T * 255.f);
-			const uint8 B = static_cast<uint8>((1.f - T) * 255.f);
-			const FColor Color(R, 0, B, 180);
+				const bool bAwake = AwakeTiles[TY * FluidConstants::TilesPerSide + TX];
+				if (WetCells == 0 && !bAwake) { continue; }
+				if (WetCells == 0)
+				{
+					MaxSurface = Grid[GetCellIndex(TX * FluidConstants::TileSize, TY * FluidConstants::TileSize)].GetSurfaceHeight();
+				}
 
-			const FVector CellCenter = CellToWorld(X, Y);
-			const float HalfHeight = FMath::Max(Cell.FluidVolume * 0.5f, 1.f);
-			const FVector BoxCenter(
-				CellCenter.X,
-				CellCenter.Y,
-				Cell.TerrainHeight + HalfHeight
-			);
-			const FVector HalfExtent(
-				CellWorldSize * 0.45f,
-				CellWorldSize * 0.45f,
-				HalfHeight
-			);
+				const float Fill = static_cast<float>(WetCells) / (FluidConstants::TileSize * FluidConstants::TileSize);
+				const FVector TileCenter = (CellToWorld(TX * FluidConstants::TileSize, TY * FluidConstants::TileSize)
+					+ CellToWorld((TX + 1) * FluidConstants::TileSize - 1, (TY + 1) * FluidConstants::TileSize - 1)) * 0.5f;
+
+				FFluidDebugQuad& Quad = Quads.AddDefaulted_GetRef();
+				Quad.Center = FVector3f(TileCenter.X, TileCenter.Y, MaxSurface + 1.f);
+				Quad.HalfExtent = TileHalfExtent;
+				Quad.Color = bAwake
+					? FColor(0, static_cast<uint8>(80.f + Fill * 175.f), 0, 255)
+					: FColor(90, 90, 90, 255);
+			}
+		}
+	}
+	else
+	{
+		Quads.Reserve(FluidConstants::TotalCells / 4);
+
+		for (int32 Y = 0; Y < FluidConstants::GridSize; ++Y)
+		{
+			for (int32 X = 0; X < FluidConstants::GridSize; ++X)
+			{
+				const int32 Idx = GetCellIndex(X, Y);
+				const FFluidCell& Cell = Grid[Idx];
+				const bool bWet = Cell.FluidVolume >= KINDA_SMALL_NUMBER;
+
+				FColor Color;
+				switch (Mode)
+				{
+				case EFluidDebugMode::Velocity:
+				{
+					if (!bWet) { continue; }
+					const FVector2D& Flow = Cell.FlowVelocity;
+					const float Hue = (FMath::Atan2(Flow.Y, Flow.X) + PI) / (2.f * PI);
+					const float Speed = FMath::Clamp(Flow.Size() / MaxFlow, 0.f, 1.f);
+					Color = FLinearColor::MakeFromHSV8(
+						static_cast<uint8>(Hue * 255.f), 255, static_cast<uint8>(40.f + Speed * 215.f)).ToFColor(true);
+					break;
+				}
+				case EFluidDebugMode::FrozenBlocked:
+				{
+					if (Cell.bBlocked)     { Color = FColor(255, 140, 0); }
+					else if (Cell.bFrozen) { Color = FColor(160, 240, 255); }
+					else if (bWet)         { Color = FColor(20, 30, 90); }
+					else                   { continue; }
+					break;
+				}
+				case EFluidDebugMode::StepCost:
+				{
+					const uint8 Cost = CellStepCost[Idx];
+					if (Cost == 0) { continue; }
+					const float T = FMath::Clamp((Cost - 1) / (MaxStepCost - 1.f), 0.f, 1.f);
+					Color = FColor(static_cast<uint8>(T * 255.f), static_cast<uint8>((1.f - T) * 255.f), 0);
+					break;
+				}
+				case EFluidDebugMode::Lakes:
+				{
+					const int32 LakeId = CellLakeIds[Idx];
+					if (LakeId != INDEX_NONE)
+					{
+						// Golden-ratio hue step keeps neighbouring lake ids distinct
+						const uint8 Hue = static_cast<uint8>(FMath::Frac(LakeId * 0.618034f) * 255.f);
+						Color = FLinearColor::MakeFromHSV8(Hue, 200, 255).ToFColor(true);
+					}
+					else if (bWet) { Color = FColor(40, 40, 40); }
+					else           { continue; }
+					break;
+				}
+				case EFluidDebugMode::Basins:
+				{
+					const int32 BasinId = CellBasinIds[Idx];
+					if (BasinId == INDEX_NONE) { continue; }
+					const uint8 Hue = static_cast<uint8>(FMath::Frac(BasinId * 0.618034f) * 255.f);
+					Color = FLinearColor::MakeFromHSV8(Hue, 200, bWet ? 255 : 110).ToFColor(true);
+					break;
+				}
+				case EFluidDebugMode::Depth:
+				default:
+				{
+					if (!bWet) { continue; }
+					const float T = FMath::Clamp(Cell.FluidVolume / MaxDepth, 0.f, 1.f);
+					Color = FColor(static_cast<uint8>(T * 255.f), 0, static_cast<uint8>((1.f - T) * 255.f));
+					break;
+				}
+				}
 
-			DrawDebugBox(World, BoxCenter, HalfExtent, Color,
-				/*bPersistent=*/false, /*LifeTime=*/SimStepRate * 1.1f);
+				const FVector CellCenter = CellToWorld(X, Y);
+				FFluidDebugQuad& Quad = Quads.AddDefaulted_GetRef();
+				Quad.Center = FVector3f(CellCenter.X, CellCenter.Y, Cell.GetSurfaceHeight() + 1.f);
+				Quad.HalfExtent = CellHalfExtent;
+				Quad.Color = Color;
+			}
 		}
 	}
+
+	DebugComponent->SetQuads(MoveTemp(Quads));
 }
 
 // ---------------------------------------------------------------------------
@@ -259,11 +2365,12 @@ void UFluidSubsystem::UpdateRenderTargets()
 		TArray<FFloat16Color> HalfPixels;
 		HalfPixels.SetNum(Size * Size);
 
+		// Render targets are row-major; this is where the cell layout is converted
 		for (int32 I = 0; I < FluidConstants::TotalCells; ++I)
 		{
 			const float SurfaceHeight = Grid[I].GetSurfaceHeight();
 			const float HasFluid = Grid[I].FluidVolume > KINDA_SMALL_NUMBER ? 1.f : 0.f;
-			HalfPixels[I] = FFloat16Color(FLinearColor(SurfaceHeight, Grid[I].FluidVolume, 0.f, HasFluid));
+			HalfPixels[FluidGrid::RowMajorIndex(I)] = FFloat16Color(FLinearColor(SurfaceHeight, Grid[I].FluidVolume, 0.f, HasFluid));
 		}
 
 		FTextureRenderTargetResource* RTResource = HeightRenderTarget->GameThread_GetRenderTargetResource();
@@ -305,11 +2412,11 @@ void UFluidSubsystem::UpdateRenderTargets()
 		{
 			const FVector2D& Flow = Grid[I].FlowVelocity;
 			// Encode signed velocity into [0,1] range: 0.5 = zero, 0 = -MaxFlow, 1 = +MaxFlow
-			const float MaxFlow = 500.f;
+			const float MaxFlow = FluidConstants::FlowEncodeRange;
 			const float R = FMath::Clamp((Flow.X / MaxFlow) * 0.5f + 0.5f, 0.f, 1.f);
 			const float G = FMath::Clamp((Flow.Y / MaxFlow) * 0.5f + 0.5f, 0.f, 1.f);
 			const float B = Grid[I].bFrozen ? 1.f : 0.f;
-			HalfPixels[I] = FFloat16Color(FLinearColor(R, G, B, 1.f));
+			HalfPixels[FluidGrid::RowMajorIndex(I)] = FFloat16Color(FLinearColor(R, G, B, 1.f));
 		}
 
 		FTextureRenderTargetResource* RTResource = FlowRenderTarget->GameThread_GetRenderTargetResource();
@@ -363,6 +2470,27 @@ FVector UFluidSubsystem::CellToWorld(int32 X, int32 Y) const
 	);
 }
 
+TSharedRef<const FFluidGridSnapshot, ESPMode::ThreadSafe> UFluidSubsystem::GetGridSnapshot() const
+{
+	if (!GridSnapshot)
+	{
+		// Never written after publishing; the next step publishes a fresh one
+		TSharedRef<FFluidGridSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FFluidGridSnapshot, ESPMode::ThreadSafe>();
+		Snapshot->Cells.SetNumUninitialized(Grid.Num());
+		for (int32 I = 0; I < Grid.Num(); ++I)
+		{
+			const FFluidCell& Cell = Grid[I];
+			FFluidSnapshotCell& Out = Snapshot->Cells[I];
+			Out.SurfaceHeight = Cell.GetSurfaceHeight();
+			Out.Depth = Cell.FluidVolume;
+			Out.FlowVelocity = FVector2f(Cell.FlowVelocity);
+			Out.bFrozen = Cell.bFrozen;
+		}
+		GridSnapshot = Snapshot;
+	}
+	return GridSnapshot.ToSharedRef();
+}
+
 bool UFluidSubsystem::IsValidCell(int32 X, int32 Y) const
 {
 	return X >= 0 && X < FluidConstants::GridSize
@@ -372,7 +2500,7 @@ bool UFluidSubsystem::IsValidCell(int32 X, int32 Y) const
 int32 UFluidSubsystem::GetCellIndex(int32 X, int32 Y) const
 {
 	checkf(IsValidCell(X, Y), TEXT("GetCellIndex called with invalid coords (%d, %d)"), X, Y);
-	return Y * FluidConstants::GridSize + X;
+	return FluidGrid::CellIndex(X, Y);
 }
 
 // ---------------------------------------------------------------------------
@@ -386,129 +2514,191 @@ float UFluidSubsystem::GetFluidHeightAtWorldPos(FVector WorldPos) const
 	return Grid[GetCellIndex(Cell.X, Cell.Y)].GetSurfaceHeight();
 }
 
-void UFluidSubsystem::AddFluidAtCell(int32 X, int32 Y, float Amount)
+FFluidSample UFluidSubsystem::SampleFluidAtWorldPos(FVector WorldPos) const
 {
-	if (!IsValidCell(X, Y) || Amount <= 0.f) { return; }
-	Grid[GetCellIndex(X, Y)].FluidVolume += Amount;
-}
+	FFluidSample Sample;
 
-void UFluidSubsystem::RemoveFluidInRadius(FVector WorldPos, float Radius, float Amount)
-{
-	const FIntPoint Center = WorldToCell(WorldPos);
-	const int32 CellRadius = FMath::CeilToInt(Radius / CellWorldSize);
+	const FIntPoint Cell = WorldToCell(WorldPos);
+	if (!IsValidCell(Cell.X, Cell.Y)) { return Sample; }
+
+	// Continuous cell coordinate with cell centres on integers
+	const float FX = (WorldPos.X - GridWorldOrigin.X) / CellWorldSize - 0.5f;
+	const float FY = (WorldPos.Y - GridWorldOrigin.Y) / CellWorldSize - 0.5f;
+	const int32 X0 = FMath::FloorToInt(FX);
+	const int32 Y0 = FMath::FloorToInt(FY);
+	const float TX = FX - X0;
+	const float TY = FY - Y0;
+
+	// Half a cell inside the grid edge the outer row is clamped, which flattens the gradient there
+	const int32 Max = FluidConstants::GridSize - 1;
+	const FFluidCell& C00 = Grid[GetCellIndex(FMath::Clamp(X0, 0, Max),     FMath::Clamp(Y0, 0, Max))];
+	const FFluidCell& C10 = Grid[GetCellIndex(FMath::Clamp(X0 + 1, 0, Max), FMath::Clamp(Y0, 0, Max))];
+	const FFluidCell& C01 = Grid[GetCellIndex(FMath::Clamp(X0, 0, Max),     FMath::Clamp(Y0 + 1, 0, Max))];
+	const FFluidCell& C11 = Grid[GetCellIndex(FMath::Clamp(X0 + 1, 0, Max), FMath::Clamp(Y0 + 1, 0, Max))];
+
+	const float H00 = C00.GetSurfaceHeight();
+	const float H10 = C10.GetSurfaceHeight();
+	const float H01 = C01.GetSurfaceHeight();
+	const float H11 = C11.GetSurfaceHeight();
+
+	Sample.SurfaceHeight = FMath::BiLerp(H00, H10, H01, H11, TX, TY);
+	Sample.Depth = FMath::BiLerp(C00.FluidVolume, C10.FluidVolume, C01.FluidVolume, C11.FluidVolume, TX, TY);
+	Sample.FlowVelocity = FMath::BiLerp(C00.FlowVelocity, C10.FlowVelocity, C01.FlowVelocity, C11.FlowVelocity, TX, TY);
+
+	// Analytic derivative of the bilinear patch
+	Sample.Gradient.X = FMath::Lerp(H10 - H00, H11 - H01, TY) / CellWorldSize;
+	Sample.Gradient.Y = FMath::Lerp(H01 - H00, H11 - H10, TX) / CellWorldSize;
+	Sample.Normal = FVector(-Sample.Gradient.X, -Sample.Gradient.Y, 1.f).GetSafeNormal();
+	Sample.bValid = true;
+
+	return Sample;
+}
 
-	TArray<int32, TInlineAllocator<64>> AffectedCells;
-	float TotalVolume = 0.f;
+// ---------------------------------------------------------------------------
+// Batched Queries
+// ---------------------------------------------------------------------------
 
-	for (int32 DY = -CellRadius; DY <= CellRadius; ++DY)
+void UFluidSubsystem::ResolveCellIndices4(const FVector* Positions, int32 Count, int32 OutIndices[4]) const
+{
+	alignas(32) double PX[4] = {};
+	alignas(32) double PY[4] = {};
+	for (int32 I = 0; I < Count; ++I)
 	{
-		for (int32 DX = -CellRadius; DX <= CellRadius; ++DX)
-		{
-			const int32 X = Center.X + DX;
-			const int32 Y = Center.Y + DY;
-			if (!IsValidCell(X, Y)) { continue; }
-
-			const FVector CellPos = CellToWorld(X, Y);
-			if (FVector2D::Distance(FVector2D(WorldPos), FVector2D(CellPos)) > Radius) { continue; }
-
-			const int32 Idx = GetCellIndex(X, Y);
-			if (Grid[Idx].FluidVolume <= 0.f) { continue; }
-
-			AffectedCells.Add(Idx);
-			TotalVolume += Grid[Idx].FluidVolume;
-		}
+		PX[I] = Positions[I].X;
+		PY[I] = Positions[I].Y;
 	}
 
-	if (TotalVolume <= 0.f) { return; }
+	// Same floor((P - Origin) / CellWorldSize) as WorldToCell, four lanes at once. Kept in double like
+	// the scalar path; a float round trip moves positions near a cell edge into the neighbour.
+	const double CellSize = CellWorldSize;
+	const VectorRegister4Double OriginX = MakeVectorRegisterDouble(GridWorldOrigin.X, GridWorldOrigin.X, GridWorldOrigin.X, GridWorldOrigin.X);
+	const VectorRegister4Double OriginY = MakeVectorRegisterDouble(GridWorldOrigin.Y, GridWorldOrigin.Y, GridWorldOrigin.Y, GridWorldOrigin.Y);
+	const VectorRegister4Double Cell = MakeVectorRegisterDouble(CellSize, CellSize, CellSize, CellSize);
 
-	// Proportional removal: deeper cells lose more volume. This gives a natural
-	// "draining the deepest part first" feel for evaporators and the heat lance.
-	const float RemoveFraction = FMath::Min(Amount / TotalVolume, 1.f);
-	for (const int32 Idx : AffectedCells)
+	alignas(32) double FX[4];
+	alignas(32) double FY[4];
+	VectorStoreAligned(VectorFloor(VectorDivide(VectorSubtract(VectorLoadAligned(PX), OriginX), Cell)), FX);
+	VectorStoreAligned(VectorFloor(VectorDivide(VectorSubtract(VectorLoadAligned(PY), OriginY), Cell)), FY);
+
+	for (int32 I = 0; I < Count; ++I)
 	{
-		Grid[Idx].FluidVolume = FMath::Max(0.f, Grid[Idx].FluidVolume * (1.f - RemoveFraction));
+		const int32 X = static_cast<int32>(FX[I]);
+		const int32 Y = static_cast<int32>(FY[I]);
+		OutIndices[I] = IsValidCell(X, Y) ? GetCellIndex(X, Y) : INDEX_NONE;
 	}
 }
 
-void UFluidSubsystem::ApplyForceInRadius(FVector Center, float Radius, FVector2D Force)
+template <typename TValue, typename TReadFunc>
+void UFluidSubsystem::GatherCellValues(TConstArrayView<FVector> Positions, TArrayView<TValue> Out, const TValue& Fallback, TReadFunc&& Read) const
 {
-	const FIntPoint CenterCell = WorldToCell(Center);
-	const int32 CellRadius = FMath::CeilToInt(Radius / CellWorldSize);
+	check(Out.Num() >= Positions.Num());
 
-	for (int32 DY = -CellRadius; DY <= CellRadius; ++DY)
+	for (int32 Base = 0; Base < Positions.Num(); Base += 4)
 	{
-		for (int32 DX = -CellRadius; DX <= CellRadius; ++DX)
+		const int32 Count = FMath::Min(4, Positions.Num() - Base);
+		int32 Indices[4];
+		ResolveCellIndices4(Positions.GetData() + Base, Count, Indices);
+
+		for (int32 I = 0; I < Count; ++I)
 		{
-			const int32 X = CenterCell.X + DX;
-			const int32 Y = CenterCell.Y + DY;
-			if (!IsValidCell(X, Y)) { continue; }
+			Out[Base + I] = Indices[I] != INDEX_NONE ? Read(Grid[Indices[I]]) : Fallback;
+		}
+	}
+}
 
-			const FVector CellPos = CellToWorld(X, Y);
-			const float Dist = FVector2D::Distance(FVector2D(Center), FVector2D(CellPos));
-			if (Dist > Radius) { continue; }
+void UFluidSubsystem::GetFluidHeightsAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<float> OutHeights) const
+{
+	GatherCellValues(Positions, OutHeights, 0.f, [](const FFluidCell& Cell) { return Cell.GetSurfaceHeight(); });
+}
 
-			const int32 Idx = GetCellIndex(X, Y);
-			if (Grid[Idx].FluidVolume <= KINDA_SMALL_NUMBER) { continue; }
+void UFluidSubsystem::GetFluidDepthsAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<float> OutDepths) const
+{
+	GatherCellValues(Positions, OutDepths, 0.f, [](const FFluidCell& Cell) { return Cell.FluidVolume; });
+}
 
-			const float Falloff = 1.f - (Dist / Radius);
-			Grid[Idx].FlowVelocity += Force * Falloff;
-		}
+void UFluidSubsystem::GetFlowVelocitiesAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<FVector2D> OutVelocities) const
+{
+	GatherCellValues(Positions, OutVelocities, FVector2D::ZeroVector, [](const FFluidCell& Cell) { return Cell.FlowVelocity; });
+}
+
+void UFluidSubsystem::SampleFluidAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<FFluidSample> OutSamples) const
+{
+	check(OutSamples.Num() >= Positions.Num());
+	for (int32 I = 0; I < Positions.Num(); ++I)
+	{
+		OutSamples[I] = SampleFluidAtWorldPos(Positions[I]);
 	}
 }
 
-void UFluidSubsystem::ApplyRadialForceInRadius(FVector Center, float Radius, float Strength)
+void UFluidSubsystem::K2_SampleFluidAtWorldPositions(const TArray<FVector>& Positions, TArray<FFluidSample>& OutSamples) const
 {
-	const FIntPoint CenterCell = WorldToCell(Center);
-	const int32 CellRadius = FMath::CeilToInt(Radius / CellWorldSize);
+	OutSamples.SetNum(Positions.Num());
+	SampleFluidAtWorldPositions(Positions, OutSamples);
+}
 
-	for (int32 DY = -CellRadius; DY <= CellRadius; ++DY)
-	{
-		for (int32 DX = -CellRadius; DX <= CellRadius; ++DX)
-		{
-			const int32 X = CenterCell.X + DX;
-			const int32 Y = CenterCell.Y + DY;
-			if (!IsValidCell(X, Y)) { continue; }
+void UFluidSubsystem::K2_GetFluidHeightsAtWorldPositions(const TArray<FVector>& Positions, TArray<float>& OutHeights) const
+{
+	OutHeights.SetNumUninitialized(Positions.Num());
+	GetFluidHeightsAtWorldPositions(Positions, OutHeights);
+}
 
-			const FVector CellPos = CellToWorld(X, Y);
-			const FVector2D Offset(CellPos.X - Center.X, CellPos.Y - Center.Y);
-			const float Dist = Offset.Size();
-			if (Dist > Radius || Dist < KINDA_SMALL_NUMBER) { continue; }
+void UFluidSubsystem::K2_GetFluidDepthsAtWorldPositions(const TArray<FVector>& Positions, TArray<float>& OutDepths) const
+{
+	OutDepths.SetNumUninitialized(Positions.Num());
+	GetFluidDepthsAtWorldPositions(Positions, OutDepths);
+}
 
-			const int32 Idx = GetCellIndex(X, Y);
-			if (Grid[Idx].FluidVolume <= KINDA_SMALL_NUMBER) { continue; }
+void UFluidSubsystem::K2_GetFlowVelocitiesAtWorldPositions(const TArray<FVector>& Positions, TArray<FVector2D>& OutVelocities) const
+{
+	OutVelocities.SetNumUninitialized(Positions.Num());
+	GetFlowVelocitiesAtWorldPositions(Positions, OutVelocities);
+}
 
-			const FVector2D Dir = Offset / Dist;
-			const float Falloff = 1.f - (Dist / Radius);
-			Grid[Idx].FlowVelocity += Dir * Strength * Falloff;
-		}
-	}
+void UFluidSubsystem::AddFluidAtCell(int32 X, int32 Y, float Amount)
+{
+	if (!IsValidCell(X, Y) || Amount <= 0.f) { return; }
+	const int32 Idx = GetCellIndex(X, Y);
+	Grid[Idx].FluidVolume += Amount;
+	NoteHeldCellWrite(Idx, Amount);
+	WakeCell(X, Y);
 }
 
-void UFluidSubsystem::SetFrozenInRadius(FVector Center, float Radius, bool bFreeze)
+float UFluidSubsystem::RemoveFluidInRadius(FVector WorldPos, float Radius, float Amount)
 {
-	const FIntPoint CenterCell = WorldToCell(Center);
-	const int32 CellRadius = FMath::CeilToInt(Radius / CellWorldSize);
+	FFluidRegion Region;
+	BuildRegion(WorldPos, Radius, Region);
+	return RemoveFluidInCells(Region, Amount);
+}
 
-	for (int32 DY = -CellRadius; DY <= CellRadius; ++DY)
-	{
-		for (int32 DX = -CellRadius; DX <= CellRadius; ++DX)
-		{
-			const int32 X = CenterCell.X + DX;
-			const int32 Y = CenterCell.Y + DY;
-			if (!IsValidCell(X, Y)) { continue; }
+void UFluidSubsystem::ApplyForceInRadius(FVector Center, float Radius, FVector2D Force)
+{
+	FFluidRegion Region;
+	BuildRegion(Center, Radius, Region);
+	ApplyForceInCells(Region, Force);
+}
 
-			const FVector CellPos = CellToWorld(X, Y);
-			if (FVector2D::Distance(FVector2D(Center), FVector2D(CellPos)) > Radius) { continue; }
+void UFluidSubsystem::ApplyRadialForceInRadius(FVector Center, float Radius, float Strength)
+{
+	FFluidRegion Region;
+	BuildRegion(Center, Radius, Region);
+	ApplyRadialForceInCells(Region, Strength);
+}
 
-			Grid[GetCellIndex(X, Y)].bFrozen = bFreeze;
-		}
-	}
+void UFluidSubsystem::SetFrozenInRadius(FVector Center, float Radius, bool bFreeze)
+{
+	FFluidRegion Region;
+	BuildRegion(Center, Radius, Region);
+	SetFrozenInCells(Region, bFreeze);
 }
 
 void UFluidSubsystem::SetBlockedAtCell(int32 X, int32 Y, bool bBlock)
 {
 	if (!IsValidCell(X, Y)) { return; }
-	Grid[GetCellIndex(X, Y)].bBlocked = bBlock;
+	DissolveLakeAtCell(GetCellIndex(X, Y));
+	FluidKernel::SetBlocked(Grid, NeighborMasks, X, Y, bBlock, TileBlockedCounts);
+
+	++TerrainRevision;
+	WakeCell(X, Y);
 }
 
 float UFluidSubsystem::GetTotalFluidVolume() const
@@ -4,9 +4,14 @@
 #include "Fluid/FluidSubsystem.h"
 #include "Fluid/FluidTypes.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
 #include "Engine/World.h"
+#include "TimerManager.h"
 
 AFluidSurfaceRenderer::AFluidSurfaceRenderer()
 {
@@ -18,6 +23,12 @@ AFluidSurfaceRenderer::AFluidSurfaceRenderer()
 	// Mesh assigned in Blueprint (128x128 subdivided plane)
 	FluidPlaneMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	FluidPlaneMesh->SetCastShadow(false);
+
+	// Clipmap patches — only populated when SurfaceMode == Clipmap
+	PatchInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("PatchInstances"));
+	PatchInstances->SetupAttachment(FluidPlaneMesh);
+	PatchInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	PatchInstances->SetCastShadow(false);
 }
 
 void AFluidSurfaceRenderer::BeginPlay()
@@ -27,9 +38,17 @@ void AFluidSurfaceRenderer::BeginPlay()
 	CreateRenderTargets();
 
 	// Register render targets with subsystem
-	if (UFluidSubsystem* Subsystem = GetWorld()->GetSubsystem<UFluidSubsystem>())
+	FluidSubsystem = GetWorld()->GetSubsystem<UFluidSubsystem>();
+	if (FluidSubsystem)
+	{
+		FluidSubsystem->SetRenderTargets(HeightRenderTarget, FlowRenderTarget);
+	}
+
+	const bool bClipmap = SurfaceMode == EFluidSurfaceMode::Clipmap && PatchMesh && FluidSubsystem;
+	FluidPlaneMesh->SetVisibility(!bClipmap);
+	if (bClipmap)
 	{
-		Subsystem->SetRenderTargets(HeightRenderTarget, FlowRenderTarget);
+		PatchInstances->SetStaticMesh(PatchMesh);
 	}
 
 	// Create dynamic material instance and bind textures
@@ -37,6 +56,15 @@ void AFluidSurfaceRenderer::BeginPlay()
 	{
 		DynamicMaterial = UMaterialInstanceDynamic::Create(FluidMaterial, this);
 		FluidPlaneMesh->SetMaterial(0, DynamicMaterial);
+		PatchInstances->SetMaterial(0, DynamicMaterial);
+
+		// World-space UV mapping for patch meshes, which do not span the grid
+		if (FluidSubsystem)
+		{
+			DynamicMaterial->SetVectorParameterValue(TEXT("GridOrigin"), FLinearColor(FluidSubsystem->GetGridWorldOrigin()));
+			DynamicMaterial->SetScalarParameterValue(TEXT("GridWorldSize"),
+				FluidConstants::GridSize * FluidSubsystem->GetCellWorldSize());
+		}
 
 		if (HeightRenderTarget)
 		{
@@ -47,6 +75,23 @@ void AFluidSurfaceRenderer::BeginPlay()
 			DynamicMaterial->SetTextureParameterValue(TEXT("FlowTexture"), FlowRenderTarget);
 		}
 	}
+
+	if (bClipmap && GetNetMode() != NM_DedicatedServer)
+	{
+		GetWorldTimerManager().SetTimer(
+			PatchUpdateHandle,
+			FTimerDelegate::CreateUObject(this, &AFluidSurfaceRenderer::UpdatePatches),
+			PatchUpdateInterval,
+			/*bLoop=*/true,
+			/*InFirstDelay=*/0.f
+		);
+	}
+}
+
+void AFluidSurfaceRenderer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(PatchUpdateHandle);
+	Super::EndPlay(EndPlayReason);
 }
 
 void AFluidSurfaceRenderer::CreateRenderTargets()
@@ -75,3 +120,94 @@ void AFluidSurfaceRenderer::CreateRenderTargets()
 		FlowRenderTarget->UpdateResourceImmediate(true);
 	}
 }
+
+// ---------------------------------------------------------------------------
+// Clipmap Patches
+// ---------------------------------------------------------------------------
+
+void AFluidSurfaceRenderer::UpdatePatches()
+{
+	if (!FluidSubsystem || !PatchMesh) { return; }
+
+	FVector2D ViewXY(GetActorLocation());
+	if (const APlayerController* PC = GetWorld()->GetFirstPlayerController())
+	{
+		if (PC->PlayerCameraManager)
+		{
+			ViewXY = FVector2D(PC->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(CurrentPatchTransforms.Num());
+	EmitPatches(0, 0, FluidConstants::GridSize, ViewXY, Transforms);
+
+	// Skip the instance rebuild when neither the camera nor the wet area moved a patch
+	bool bChanged = Transforms.Num() != CurrentPatchTransforms.Num();
+	for (int32 I = 0; !bChanged && I < Transforms.Num(); ++I)
+	{
+		bChanged = !Transforms[I].Equals(CurrentPatchTransforms[I], 0.1f);
+	}
+	if (!bChanged) { return; }
+
+	PatchInstances->ClearInstances();
+	PatchInstances->AddInstances(Transforms, /*bShouldReturnIndices=*/false, /*bWorldSpace=*/true);
+	CurrentPatchTransforms = MoveTemp(Transforms);
+}
+
+void AFluidSurfaceRenderer::EmitPatches(int32 CellX, int32 CellY, int32 SizeCells, const FVector2D& ViewXY,
+	TArray<FTransform>& OutTransforms) const
+{
+	// Cull nodes that sit entirely over dry tiles
+	if (!IsRegionWet(CellX, CellY, SizeCells)) { return; }
+
+	const float CellSize = FluidSubsystem->GetCellWorldSize();
+	const FVector Origin = FluidSubsystem->GetGridWorldOrigin();
+	const float NodeWorldSize = SizeCells * CellSize;
+	const FVector2D NodeMin(Origin.X + CellX * CellSize, Origin.Y + CellY * CellSize);
+	const FVector2D NodeMax = NodeMin + FVector2D(NodeWorldSize, NodeWorldSize);
+
+	// Distance from the camera to the node's footprint (zero when inside)
+	const FVector2D Closest(
+		FMath::Clamp(ViewXY.X, NodeMin.X, NodeMax.X),
+		FMath::Clamp(ViewXY.Y, NodeMin.Y, NodeMax.Y));
+	const float Dist = FVector2D::Distance(ViewXY, Closest);
+
+	if (SizeCells > MinPatchCells && Dist < NodeWorldSize * LODDistanceFactor)
+	{
+		const int32 Half = SizeCells / 2;
+		EmitPatches(CellX,        CellY,        Half, ViewXY, OutTransforms);
+		EmitPatches(CellX + Half, CellY,        Half, ViewXY, OutTransforms);
+		EmitPatches(CellX,        CellY + Half, Half, ViewXY, OutTransforms);
+		EmitPatches(CellX + Half, CellY + Half, Half, ViewXY, OutTransforms);
+		return;
+	}
+
+	const FVector2D Center = (NodeMin + NodeMax) * 0.5f;
+	const float Scale = NodeWorldSize / PatchMeshWorldSize;
+	OutTransforms.Emplace(
+		FQuat::Identity,
+		FVector(Center.X, Center.Y, GetActorLocation().Z),
+		FVector(Scale, Scale, 1.f));
+}
+
+bool AFluidSurfaceRenderer::IsRegionWet(int32 CellX, int32 CellY, int32 SizeCells) const
+{
+	const TBitArray<>& WetTiles = FluidSubsystem->GetWetTileMask();
+	if (WetTiles.Num() != FluidConstants::TotalTiles) { return true; }
+
+	// Nodes smaller than a tile test their containing tile (conservative)
+	const int32 TX0 = CellX / FluidConstants::TileSize;
+	const int32 TY0 = CellY / FluidConstants::TileSize;
+	const int32 TX1 = (CellX + SizeCells - 1) / FluidConstants::TileSize;
+	const int32 TY1 = (CellY + SizeCells - 1) / FluidConstants::TileSize;
+
+	for (int32 TY = TY0; TY <= TY1; ++TY)
+	{
+		for (int32 TX = TX0; TX <= TX1; ++TX)
+		{
+			if (WetTiles[TY * FluidConstants::TilesPerSide + TX]) { return true; }
+		}
+	}
+	return false;
+}
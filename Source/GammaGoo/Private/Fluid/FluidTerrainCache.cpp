@@ -0,0 +1,219 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/FluidTerrainCache.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// ---------------------------------------------------------------------------
+// Serialization
+// ---------------------------------------------------------------------------
+
+FArchive& operator<<(FArchive& Ar, FFluidTerrainCache& Cache)
+{
+	Ar << Cache.GeometryHash;
+	Ar << Cache.GridSize;
+	Ar << Cache.CellWorldSize;
+	Ar << Cache.GridWorldOrigin;
+
+	// Planes are written as raw blocks so loading is a straight memcpy
+	const int32 NumCells = Cache.GridSize * Cache.GridSize;
+	if (Ar.IsLoading())
+	{
+		Cache.TerrainHeights.SetNumUninitialized(NumCells);
+		Cache.NeighborMasks.SetNumUninitialized(NumCells);
+	}
+	Ar.Serialize(Cache.TerrainHeights.GetData(), NumCells * sizeof(float));
+	Ar.Serialize(Cache.NeighborMasks.GetData(), NumCells * sizeof(uint8));
+
+	return Ar;
+}
+
+bool FFluidTerrainCache::Load(const FString& Path, uint64 ExpectedHash)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent)) { return false; }
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != FileMagic || Version != FileVersion) { return false; }
+
+	// Validate the header before trusting the plane sizes
+	const int64 HeaderEnd = Reader.Tell();
+	Reader << GeometryHash;
+	Reader << GridSize;
+	if (GeometryHash != ExpectedHash || GridSize <= 0) { return false; }
+
+	const int64 Expected = HeaderEnd + sizeof(uint64) + sizeof(int32) + sizeof(float) + sizeof(FVector)
+		+ static_cast<int64>(GridSize) * GridSize * (sizeof(float) + sizeof(uint8));
+	if (Bytes.Num() != Expected) { return false; }
+
+	Reader.Seek(HeaderEnd);
+	Reader << *this;
+	return !Reader.IsError();
+}
+
+bool FFluidTerrainCache::Save(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << const_cast<FFluidTerrainCache&>(*this);
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), /*Tree=*/true);
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+// ---------------------------------------------------------------------------
+// Keys
+// ---------------------------------------------------------------------------
+
+FString FFluidTerrainCache::GetCachePath(const UWorld* World)
+{
+	const FString PackageName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+	return FPaths::ProjectContentDir() / TEXT("FluidCache") / (FPackageName::GetShortName(PackageName) + TEXT(".fluidterrain"));
+}
+
+uint64 FFluidTerrainCache::ComputeGeometryHash(const UWorld* World, const FVector& GridWorldOrigin, float CellWorldSize, int32 GridSize)
+{
+	const float GridExtent = GridSize * CellWorldSize;
+	const FBox GridBox(
+		FVector(GridWorldOrigin.X, GridWorldOrigin.Y, -UE_OLD_HALF_WORLD_MAX),
+		FVector(GridWorldOrigin.X + GridExtent, GridWorldOrigin.Y + GridExtent, UE_OLD_HALF_WORLD_MAX));
+
+	// Hash each relevant component on its own, then sort so actor iteration order doesn't matter
+	TArray<uint64> ComponentHashes;
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		It->ForEachComponent<UPrimitiveComponent>(/*bIncludeFromChildActors=*/false,
+			[&](const UPrimitiveComponent* Prim)
+			{
+				if (!Prim->IsRegistered() || Prim->Mobility != EComponentMobility::Static) { return; }
+				if (!Prim->IsCollisionEnabled()) { return; }
+				if (Prim->GetCollisionResponseToChannel(ECC_WorldStatic) != ECR_Block) { return; }
+				if (!Prim->Bounds.GetBox().Intersect(GridBox)) { return; }
+
+				// PIE paths carry UEDPIE_N_; strip it so a PIE bake validates in -game and packaged builds
+				FXxHash64Builder Builder;
+				const FString PathName = UWorld::RemovePIEPrefix(Prim->GetPathName());
+				Builder.Update(*PathName, PathName.Len() * sizeof(TCHAR));
+
+				const FTransform& Xform = Prim->GetComponentTransform();
+				const FVector Location = Xform.GetLocation();
+				const FQuat Rotation = Xform.GetRotation();
+				const FVector Scale = Xform.GetScale3D();
+				const FBox Bounds = Prim->Bounds.GetBox();
+				Builder.Update(&Location, sizeof(Location));
+				Builder.Update(&Rotation, sizeof(Rotation));
+				Builder.Update(&Scale, sizeof(Scale));
+				Builder.Update(&Bounds.Min, sizeof(Bounds.Min));
+				Builder.Update(&Bounds.Max, sizeof(Bounds.Max));
+
+				if (const UStaticMeshComponent* MeshComp = Cast<UStaticMeshComponent>(Prim))
+				{
+					if (const UStaticMesh* Mesh = MeshComp->GetStaticMesh())
+					{
+						const FString MeshPath = Mesh->GetPathName();
+						Builder.Update(*MeshPath, MeshPath.Len() * sizeof(TCHAR));
+
+						// The traces hit collision, and the body setup GUID is regenerated whenever it is rebuilt
+						// (reimport, collision edit). Both are serialized, so the hash matches in cooked builds.
+						if (const UBodySetup* BodySetup = Mesh->GetBodySetup())
+						{
+							Builder.Update(&BodySetup->BodySetupGuid, sizeof(BodySetup->BodySetupGuid));
+						}
+						const FBoxSphereBounds MeshBounds = Mesh->GetBounds();
+						Builder.Update(&MeshBounds.BoxExtent, sizeof(MeshBounds.BoxExtent));
+						Builder.Update(&MeshBounds.Origin, sizeof(MeshBounds.Origin));
+					}
+				}
+				else if (const ULandscapeHeightfieldCollisionComponent* Heightfield = Cast<ULandscapeHeightfieldCollisionComponent>(Prim))
+				{
+					// Sculpting regenerates the heightfield GUID
+					Builder.Update(&Heightfield->HeightfieldGuid, sizeof(Heightfield->HeightfieldGuid));
+				}
+
+				ComponentHashes.Add(Builder.Finalize().Hash);
+			});
+	}
+
+	ComponentHashes.Sort();
+
+	FXxHash64Builder Builder;
+	Builder.Update(&GridWorldOrigin, sizeof(GridWorldOrigin));
+	Builder.Update(&CellWorldSize, sizeof(CellWorldSize));
+	Builder.Update(&GridSize, sizeof(GridSize));
+	Builder.Update(ComponentHashes.GetData(), ComponentHashes.Num() * sizeof(uint64));
+	return Builder.Finalize().Hash;
+}
+
+// ---------------------------------------------------------------------------
+// Pre-warm cache
+// ---------------------------------------------------------------------------
+
+bool FFluidPrewarmCache::Load(const FString& Path, uint64 ExpectedKey)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent)) { return false; }
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != FileMagic || Version != FileVersion) { return false; }
+
+	Reader << Key;
+	Reader << GridSize;
+	if (Key != ExpectedKey || GridSize <= 0) { return false; }
+
+	const int32 NumCells = GridSize * GridSize;
+	if (Bytes.Num() != Reader.Tell() + static_cast<int64>(NumCells) * sizeof(float)) { return false; }
+
+	FluidVolumes.SetNumUninitialized(NumCells);
+	Reader.Serialize(FluidVolumes.GetData(), NumCells * sizeof(float));
+	return !Reader.IsError();
+}
+
+bool FFluidPrewarmCache::Save(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = FileMagic;
+	uint32 Version = FileVersion;
+	uint64 KeyCopy = Key;
+	int32 GridSizeCopy = GridSize;
+	Writer << Magic;
+	Writer << Version;
+	Writer << KeyCopy;
+	Writer << GridSizeCopy;
+	Writer.Serialize(const_cast<float*>(FluidVolumes.GetData()), FluidVolumes.Num() * sizeof(float));
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), /*Tree=*/true);
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+FString FFluidPrewarmCache::GetCachePath(const UWorld* World)
+{
+	return FPaths::ChangeExtension(FFluidTerrainCache::GetCachePath(World), TEXT(".fluidprewarm"));
+}
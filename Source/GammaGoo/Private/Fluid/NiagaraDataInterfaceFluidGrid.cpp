@@ -0,0 +1,394 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Fluid/NiagaraDataInterfaceFluidGrid.h"
+#include "Fluid/FluidSubsystem.h"
+#include "Fluid/FluidTypes.h"
+#include "NiagaraSystemInstance.h"
+#include "NiagaraCompileHashVisitor.h"
+#include "NiagaraShaderParametersBuilder.h"
+#include "NiagaraTypes.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "TextureResource.h"
+#include "RenderingThread.h"
+
+namespace FluidGridDI
+{
+	static const FName NAME_SampleSurfaceHeight(TEXT("SampleSurfaceHeight"));
+	static const FName NAME_SampleDepth(TEXT("SampleDepth"));
+	static const FName NAME_SampleVelocity(TEXT("SampleVelocity"));
+	static const FName NAME_SampleFrozen(TEXT("SampleFrozen"));
+
+	// Bump when the generated HLSL changes so cached GPU scripts recompile.
+	static const TCHAR* HLSLVersion = TEXT("FluidGridDI_v1");
+}
+
+// ---------------------------------------------------------------------------
+// Instance Data
+// ---------------------------------------------------------------------------
+
+/**
+ * Instance data read by the VM on Niagara workers. Snapshot is the subsystem's per-step shared copy,
+ * refreshed every tick; the live grid is written by SimStep and must never be read from here.
+ */
+struct FNDIFluidGridInstanceData
+{
+	TWeakObjectPtr<UFluidSubsystem> Subsystem;
+	TSharedPtr<const FFluidGridSnapshot, ESPMode::ThreadSafe> Snapshot;
+	FVector2f GridOrigin = FVector2f::ZeroVector;
+	float InvCellWorldSize = 1.f / FluidConstants::DefaultCellWorldSize;
+
+	/** Nearest-cell lookup, matching UFluidSubsystem::GetFluidHeightAtWorldPos. */
+	const FFluidSnapshotCell* FindCell(const FVector3f& WorldPos) const
+	{
+		if (!Snapshot) { return nullptr; }
+		const int32 X = FMath::FloorToInt((WorldPos.X - GridOrigin.X) * InvCellWorldSize);
+		const int32 Y = FMath::FloorToInt((WorldPos.Y - GridOrigin.Y) * InvCellWorldSize);
+		if (X < 0 || X >= FluidConstants::GridSize || Y < 0 || Y >= FluidConstants::GridSize) { return nullptr; }
+		return &Snapshot->Cells[FluidGrid::CellIndex(X, Y)];
+	}
+};
+
+/** Render-thread copy of everything the GPU path needs. Textures are the surface renderer's RTs. */
+struct FNDIFluidGridRenderData
+{
+	FVector2f GridOrigin = FVector2f::ZeroVector;
+	float InvCellWorldSize = 1.f / FluidConstants::DefaultCellWorldSize;
+	FTextureResource* HeightResource = nullptr;
+	FTextureResource* FlowResource = nullptr;
+};
+
+struct FNiagaraDataInterfaceProxyFluidGrid : public FNiagaraDataInterfaceProxy
+{
+	virtual int32 PerInstanceDataPassedToRenderThreadSize() const override { return sizeof(FNDIFluidGridRenderData); }
+
+	virtual void ConsumePerInstanceDataFromGameThread(void* PerInstanceData, const FNiagaraSystemInstanceID& Instance) override
+	{
+		FNDIFluidGridRenderData* Data = static_cast<FNDIFluidGridRenderData*>(PerInstanceData);
+		InstanceData_RT.Add(Instance, *Data);
+		Data->~FNDIFluidGridRenderData();
+	}
+
+	TMap<FNiagaraSystemInstanceID, FNDIFluidGridRenderData> InstanceData_RT;
+};
+
+// ---------------------------------------------------------------------------
+// UObject
+// ---------------------------------------------------------------------------
+
+UNiagaraDataInterfaceFluidGrid::UNiagaraDataInterfaceFluidGrid()
+{
+	Proxy.Reset(new FNiagaraDataInterfaceProxyFluidGrid());
+}
+
+void UNiagaraDataInterfaceFluidGrid::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		const ENiagaraTypeRegistryFlags Flags = ENiagaraTypeRegistryFlags::AllowAnyVariable | ENiagaraTypeRegistryFlags::AllowParameter;
+		FNiagaraTypeRegistry::Register(FNiagaraTypeDefinition(GetClass()), Flags);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Per-Instance Data
+// ---------------------------------------------------------------------------
+
+int32 UNiagaraDataInterfaceFluidGrid::PerInstanceDataSize() const
+{
+	return sizeof(FNDIFluidGridInstanceData);
+}
+
+bool UNiagaraDataInterfaceFluidGrid::InitPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance)
+{
+	new (PerInstanceData) FNDIFluidGridInstanceData();
+	PerInstanceTick(PerInstanceData, SystemInstance, 0.f);
+	return true;
+}
+
+void UNiagaraDataInterfaceFluidGrid::DestroyPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance)
+{
+	static_cast<FNDIFluidGridInstanceData*>(PerInstanceData)->~FNDIFluidGridInstanceData();
+
+	ENQUEUE_RENDER_COMMAND(RemoveFluidGridDIInstance)(
+		[RT_Proxy = GetProxyAs<FNiagaraDataInterfaceProxyFluidGrid>(), InstanceID = SystemInstance->GetId()](FRHICommandListImmediate&)
+		{
+			RT_Proxy->InstanceData_RT.Remove(InstanceID);
+		}
+	);
+}
+
+bool UNiagaraDataInterfaceFluidGrid::PerInstanceTick(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance, float DeltaSeconds)
+{
+	FNDIFluidGridInstanceData* InstData = static_cast<FNDIFluidGridInstanceData*>(PerInstanceData);
+
+	if (!InstData->Subsystem.IsValid())
+	{
+		const UWorld* World = SystemInstance ? SystemInstance->GetWorld() : nullptr;
+		InstData->Subsystem = World ? World->GetSubsystem<UFluidSubsystem>() : nullptr;
+	}
+
+	const UFluidSubsystem* Subsystem = InstData->Subsystem.Get();
+	if (!Subsystem)
+	{
+		InstData->Snapshot.Reset();
+		return false;
+	}
+
+	const FVector Origin = Subsystem->GetGridWorldOrigin();
+	InstData->Snapshot = Subsystem->GetGridSnapshot();
+	InstData->GridOrigin = FVector2f(Origin.X, Origin.Y);
+	InstData->InvCellWorldSize = 1.f / Subsystem->GetCellWorldSize();
+
+	// Returning false keeps the instance alive
+	return false;
+}
+
+void UNiagaraDataInterfaceFluidGrid::ProvidePerInstanceDataForRenderThread(void* DataForRenderThread, void* PerInstanceData, const FNiagaraSystemInstanceID& SystemInstance)
+{
+	const FNDIFluidGridInstanceData* InstData = static_cast<const FNDIFluidGridInstanceData*>(PerInstanceData);
+	FNDIFluidGridRenderData* RenderData = new (DataForRenderThread) FNDIFluidGridRenderData();
+
+	RenderData->GridOrigin = InstData->GridOrigin;
+	RenderData->InvCellWorldSize = InstData->InvCellWorldSize;
+
+	if (const UFluidSubsystem* Subsystem = InstData->Subsystem.Get())
+	{
+		if (UTextureRenderTarget2D* HeightRT = Subsystem->GetHeightRenderTarget())
+		{
+			RenderData->HeightResource = HeightRT->GetResource();
+		}
+		if (UTextureRenderTarget2D* FlowRT = Subsystem->GetFlowRenderTarget())
+		{
+			RenderData->FlowResource = FlowRT->GetResource();
+		}
+	}
+}
+
+// ---------------------------------------------------------------------------
+// Function Signatures
+// ---------------------------------------------------------------------------
+
+#if WITH_EDITORONLY_DATA
+void UNiagaraDataInterfaceFluidGrid::GetFunctionsInternal(TArray<FNiagaraFunctionSignature>& OutFunctions) const
+{
+	auto MakeSignature = [this](FName Name, const FNiagaraTypeDefinition& OutType, const TCHAR* OutName, const TCHAR* Description)
+	{
+		FNiagaraFunctionSignature Sig;
+		Sig.Name = Name;
+		Sig.bMemberFunction = true;
+		Sig.bRequiresContext = false;
+		Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("FluidGrid")));
+		Sig.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("WorldPosition")));
+		Sig.Outputs.Add(FNiagaraVariable(OutType, OutName));
+		Sig.Description = FText::FromString(Description);
+		return Sig;
+	};
+
+	OutFunctions.Add(MakeSignature(FluidGridDI::NAME_SampleSurfaceHeight, FNiagaraTypeDefinition::GetFloatDef(),
+		TEXT("SurfaceHeight"), TEXT("World Z of the fluid surface (terrain + fluid) at the cell under WorldPosition.")));
+	OutFunctions.Add(MakeSignature(FluidGridDI::NAME_SampleDepth, FNiagaraTypeDefinition::GetFloatDef(),
+		TEXT("Depth"), TEXT("Fluid depth (volume) at the cell under WorldPosition.")));
+	OutFunctions.Add(MakeSignature(FluidGridDI::NAME_SampleVelocity, FNiagaraTypeDefinition::GetVec2Def(),
+		TEXT("Velocity"), TEXT("Derived 2D flow velocity at the cell under WorldPosition.")));
+	OutFunctions.Add(MakeSignature(FluidGridDI::NAME_SampleFrozen, FNiagaraTypeDefinition::GetBoolDef(),
+		TEXT("Frozen"), TEXT("True if a cryo spike has frozen the cell under WorldPosition.")));
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// CPU (VectorVM)
+// ---------------------------------------------------------------------------
+
+void UNiagaraDataInterfaceFluidGrid::GetVMExternalFunction(const FVMExternalFunctionBindingInfo& BindingInfo, void* InstanceData, FVMExternalFunction& OutFunc)
+{
+	if (BindingInfo.Name == FluidGridDI::NAME_SampleSurfaceHeight)
+	{
+		OutFunc = FVMExternalFunction::CreateUObject(this, &UNiagaraDataInterfaceFluidGrid::VMSampleSurfaceHeight);
+	}
+	else if (BindingInfo.Name == FluidGridDI::NAME_SampleDepth)
+	{
+		OutFunc = FVMExternalFunction::CreateUObject(this, &UNiagaraDataInterfaceFluidGrid::VMSampleDepth);
+	}
+	else if (BindingInfo.Name == FluidGridDI::NAME_SampleVelocity)
+	{
+		OutFunc = FVMExternalFunction::CreateUObject(this, &UNiagaraDataInterfaceFluidGrid::VMSampleVelocity);
+	}
+	else if (BindingInfo.Name == FluidGridDI::NAME_SampleFrozen)
+	{
+		OutFunc = FVMExternalFunction::CreateUObject(this, &UNiagaraDataInterfaceFluidGrid::VMSampleFrozen);
+	}
+}
+
+void UNiagaraDataInterfaceFluidGrid::VMSampleSurfaceHeight(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFluidGridInstanceData> InstData(Context);
+	FNDIInputParam<FVector3f> InPosition(Context);
+	FNDIOutputParam<float> OutHeight(Context);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		const FFluidSnapshotCell* Cell = InstData->FindCell(InPosition.GetAndAdvance());
+		OutHeight.SetAndAdvance(Cell ? Cell->SurfaceHeight : 0.f);
+	}
+}
+
+void UNiagaraDataInterfaceFluidGrid::VMSampleDepth(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFluidGridInstanceData> InstData(Context);
+	FNDIInputParam<FVector3f> InPosition(Context);
+	FNDIOutputParam<float> OutDepth(Context);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		const FFluidSnapshotCell* Cell = InstData->FindCell(InPosition.GetAndAdvance());
+		OutDepth.SetAndAdvance(Cell ? Cell->Depth : 0.f);
+	}
+}
+
+void UNiagaraDataInterfaceFluidGrid::VMSampleVelocity(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFluidGridInstanceData> InstData(Context);
+	FNDIInputParam<FVector3f> InPosition(Context);
+	FNDIOutputParam<FVector2f> OutVelocity(Context);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		const FFluidSnapshotCell* Cell = InstData->FindCell(InPosition.GetAndAdvance());
+		OutVelocity.SetAndAdvance(Cell ? Cell->FlowVelocity : FVector2f::ZeroVector);
+	}
+}
+
+void UNiagaraDataInterfaceFluidGrid::VMSampleFrozen(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<FNDIFluidGridInstanceData> InstData(Context);
+	FNDIInputParam<FVector3f> InPosition(Context);
+	FNDIOutputParam<bool> OutFrozen(Context);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); ++i)
+	{
+		const FFluidSnapshotCell* Cell = InstData->FindCell(InPosition.GetAndAdvance());
+		OutFrozen.SetAndAdvance(Cell && Cell->bFrozen);
+	}
+}
+
+// ---------------------------------------------------------------------------
+// GPU
+// ---------------------------------------------------------------------------
+
+#if WITH_EDITORONLY_DATA
+bool UNiagaraDataInterfaceFluidGrid::AppendCompileHash(FNiagaraCompileHashVisitor* InVisitor) const
+{
+	bool bSuccess = Super::AppendCompileHash(InVisitor);
+	bSuccess &= InVisitor->UpdateString(TEXT("UNiagaraDataInterfaceFluidGrid_HLSL"), FluidGridDI::HLSLVersion);
+	InVisitor->UpdateShaderParameters<FShaderParameters>();
+	return bSuccess;
+}
+
+void UNiagaraDataInterfaceFluidGrid::GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, FString& OutHLSL)
+{
+	const TMap<FString, FStringFormatArg> Args = {
+		{ TEXT("ParameterName"), ParamInfo.DataInterfaceHLSLSymbol },
+	};
+
+	// Texture layout matches UFluidSubsystem::UpdateRenderTargets:
+	// Height RGBA = (SurfaceHeight, FluidVolume, unused, HasFluid), Flow RGBA = (VelX, VelY encoded, bFrozen, 1)
+	OutHLSL += FString::Format(TEXT(R"(
+float2		{ParameterName}_GridOrigin;
+float		{ParameterName}_InvCellWorldSize;
+int			{ParameterName}_GridSize;
+float		{ParameterName}_MaxFlow;
+Texture2D	{ParameterName}_HeightTexture;
+Texture2D	{ParameterName}_FlowTexture;
+
+bool {ParameterName}_TryGetCell(float3 WorldPosition, out int3 Cell)
+{
+	int2 XY = (int2)floor((WorldPosition.xy - {ParameterName}_GridOrigin) * {ParameterName}_InvCellWorldSize);
+	Cell = int3(XY, 0);
+	return all(XY >= 0) && all(XY < {ParameterName}_GridSize);
+}
+)"), Args);
+}
+
+bool UNiagaraDataInterfaceFluidGrid::GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, const FNiagaraDataInterfaceGeneratedFunction& FunctionInfo, int FunctionInstanceIndex, FString& OutHLSL)
+{
+	const TMap<FString, FStringFormatArg> Args = {
+		{ TEXT("FunctionName"), FunctionInfo.InstanceName },
+		{ TEXT("ParameterName"), ParamInfo.DataInterfaceHLSLSymbol },
+	};
+
+	if (FunctionInfo.DefinitionName == FluidGridDI::NAME_SampleSurfaceHeight)
+	{
+		OutHLSL += FString::Format(TEXT(R"(
+void {FunctionName}(float3 WorldPosition, out float OutSurfaceHeight)
+{
+	int3 Cell;
+	OutSurfaceHeight = {ParameterName}_TryGetCell(WorldPosition, Cell) ? {ParameterName}_HeightTexture.Load(Cell).r : 0.0f;
+}
+)"), Args);
+		return true;
+	}
+	if (FunctionInfo.DefinitionName == FluidGridDI::NAME_SampleDepth)
+	{
+		OutHLSL += FString::Format(TEXT(R"(
+void {FunctionName}(float3 WorldPosition, out float OutDepth)
+{
+	int3 Cell;
+	OutDepth = {ParameterName}_TryGetCell(WorldPosition, Cell) ? {ParameterName}_HeightTexture.Load(Cell).g : 0.0f;
+}
+)"), Args);
+		return true;
+	}
+	if (FunctionInfo.DefinitionName == FluidGridDI::NAME_SampleVelocity)
+	{
+		OutHLSL += FString::Format(TEXT(R"(
+void {FunctionName}(float3 WorldPosition, out float2 OutVelocity)
+{
+	int3 Cell;
+	OutVelocity = {ParameterName}_TryGetCell(WorldPosition, Cell)
+		? ({ParameterName}_FlowTexture.Load(Cell).rg * 2.0f - 1.0f) * {ParameterName}_MaxFlow
+		: float2(0.0f, 0.0f);
+}
+)"), Args);
+		return true;
+	}
+	if (FunctionInfo.DefinitionName == FluidGridDI::NAME_SampleFrozen)
+	{
+		OutHLSL += FString::Format(TEXT(R"(
+void {FunctionName}(float3 WorldPosition, out bool OutFrozen)
+{
+	int3 Cell;
+	OutFrozen = {ParameterName}_TryGetCell(WorldPosition, Cell) && {ParameterName}_FlowTexture.Load(Cell).b > 0.5f;
+}
+)"), Args);
+		return true;
+	}
+
+	return false;
+}
+#endif
+
+void UNiagaraDataInterfaceFluidGrid::BuildShaderParameters(FNiagaraShaderParametersBuilder& ShaderParametersBuilder) const
+{
+	ShaderParametersBuilder.AddNestedStruct<FShaderParameters>();
+}
+
+void UNiagaraDataInterfaceFluidGrid::SetShaderParameters(const FNiagaraDataInterfaceSetShaderParametersContext& Context) const
+{
+	const FNiagaraDataInterfaceProxyFluidGrid& DIProxy = Context.GetProxy<FNiagaraDataInterfaceProxyFluidGrid>();
+	const FNDIFluidGridRenderData* Data = DIProxy.InstanceData_RT.Find(Context.GetSystemInstanceID());
+
+	FShaderParameters* Params = Context.GetParameterNestedStruct<FShaderParameters>();
+	Params->GridSize = FluidConstants::GridSize;
+	Params->MaxFlow = FluidConstants::FlowEncodeRange;
+	Params->GridOrigin = Data ? Data->GridOrigin : FVector2f::ZeroVector;
+	Params->InvCellWorldSize = Data ? Data->InvCellWorldSize : 1.f / FluidConstants::DefaultCellWorldSize;
+
+	// Bind the surface renderer's RTs directly. Fall back to black when no renderer is placed.
+	FRHITexture* HeightRHI = (Data && Data->HeightResource) ? Data->HeightResource->TextureRHI.GetReference() : nullptr;
+	FRHITexture* FlowRHI = (Data && Data->FlowResource) ? Data->FlowResource->TextureRHI.GetReference() : nullptr;
+	Params->HeightTexture = HeightRHI ? HeightRHI : GBlackTexture->TextureRHI.GetReference();
+	Params->FlowTexture = FlowRHI ? FlowRHI : GBlackTexture->TextureRHI.GetReference();
+}
@@ -0,0 +1,349 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Game/FloodArrivalSubsystem.h"
+#include "Game/TownHall.h"
+#include "Fluid/FluidSource.h"
+#include "Fluid/FluidSubsystem.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "TextureResource.h"
+#include "TimerManager.h"
+
+void UFloodArrivalSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	FluidSubsystem = Collection.InitializeDependency<UFluidSubsystem>();
+}
+
+void UFloodArrivalSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(PollHandle);
+	}
+
+	// The job owns its inputs, so the worker never touches this object; just stop it early
+	if (PendingJob)
+	{
+		PendingJob->bCancelled = true;
+		PendingTask.Wait();
+		PendingJob.Reset();
+	}
+
+	Sources.Empty();
+	FluidSubsystem = nullptr;
+	DebugTexture = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UFloodArrivalSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(
+		PollHandle,
+		FTimerDelegate::CreateUObject(this, &UFloodArrivalSubsystem::PollArrival),
+		PollInterval,
+		/*bLoop=*/true
+	);
+}
+
+// ---------------------------------------------------------------------------
+// Sources
+// ---------------------------------------------------------------------------
+
+void UFloodArrivalSubsystem::RegisterSource(AFluidSource* Source)
+{
+	if (Source)
+	{
+		Sources.AddUnique(Source);
+	}
+}
+
+void UFloodArrivalSubsystem::UnregisterSource(AFluidSource* Source)
+{
+	Sources.Remove(Source);
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+float UFloodArrivalSubsystem::SampleArrivalTime(FVector WorldPos) const
+{
+	if (!FluidSubsystem || ArrivalTimes.Num() == 0) { return TNumericLimits<float>::Max(); }
+
+	const FIntPoint Cell = FluidSubsystem->WorldToCell(WorldPos);
+	if (!FluidSubsystem->IsValidCell(Cell.X, Cell.Y)) { return TNumericLimits<float>::Max(); }
+	return ArrivalTimes[FluidSubsystem->GetCellIndex(Cell.X, Cell.Y)];
+}
+
+float UFloodArrivalSubsystem::GetArrivalTimeAtWorldPos(FVector WorldPos) const
+{
+	return ToQueryTime(SampleArrivalTime(WorldPos));
+}
+
+float UFloodArrivalSubsystem::GetThreatAtWorldPos(FVector WorldPos) const
+{
+	const float Time = SampleArrivalTime(WorldPos);
+	if (Time >= ThreatHorizon) { return 0.f; }
+	return 1.f - Time / ThreatHorizon;
+}
+
+float UFloodArrivalSubsystem::GetSourceArrivalTime(const AFluidSource* Source) const
+{
+	for (int32 I = 0; I < FieldSources.Num(); ++I)
+	{
+		if (FieldSources[I].Get() == Source)
+		{
+			return ToQueryTime(FieldSourceTimes[I]);
+		}
+	}
+	return -1.f;
+}
+
+// ---------------------------------------------------------------------------
+// Job scheduling
+// ---------------------------------------------------------------------------
+
+uint32 UFloodArrivalSubsystem::ComputeInputsKey() const
+{
+	uint32 Key = GetTypeHash(FluidSubsystem->GetTerrainRevision());
+	Key = HashCombine(Key, GetTypeHash(TownHall.Get()));
+	for (const TWeakObjectPtr<AFluidSource>& Source : Sources)
+	{
+		Key = HashCombine(Key, GetTypeHash(Source));
+		Key = HashCombine(Key, GetTypeHash(static_cast<uint32>(Source.IsValid() && Source->IsActive())));
+	}
+	return Key;
+}
+
+void UFloodArrivalSubsystem::PollArrival()
+{
+	if (!FluidSubsystem || !FluidSubsystem->IsTerrainReady()) { return; }
+
+	if (!TownHall.IsValid())
+	{
+		for (TActorIterator<ATownHall> It(GetWorld()); It; ++It)
+		{
+			TownHall = *It;
+			break; // Only one town hall expected
+		}
+	}
+
+	Sources.RemoveAll([](const TWeakObjectPtr<AFluidSource>& Source) { return !Source.IsValid(); });
+	const uint32 Key = ComputeInputsKey();
+
+	if (PendingJob)
+	{
+		if (!PendingTask.IsCompleted())
+		{
+			// Levee placed or wave changed mid-run: stop early and relaunch once it returns. Forget the
+			// launched key too, or inputs that change back before then would match it and never relaunch.
+			if (Key != PendingJob->InputsKey)
+			{
+				PendingJob->bCancelled = true;
+				bLaunched = false;
+			}
+			return;
+		}
+
+		if (!PendingJob->bCancelled)
+		{
+			ApplyJob(*PendingJob);
+		}
+		PendingJob.Reset();
+	}
+
+	if (!bLaunched || Key != LaunchedKey)
+	{
+		LaunchJob(Key);
+	}
+}
+
+void UFloodArrivalSubsystem::LaunchJob(uint32 InputsKey)
+{
+	TSharedPtr<FArrivalJob, ESPMode::ThreadSafe> Job = MakeShared<FArrivalJob, ESPMode::ThreadSafe>();
+
+	const TConstArrayView<FFluidCell> Grid = FluidSubsystem->GetGrid();
+	Job->TerrainHeights.SetNumUninitialized(Grid.Num());
+	for (int32 I = 0; I < Grid.Num(); ++I)
+	{
+		Job->TerrainHeights[I] = Grid[I].TerrainHeight;
+	}
+	Job->NeighborMasks.Append(FluidSubsystem->GetNeighborMasks());
+
+	TArray<int32> ActiveCells;
+	for (const TWeakObjectPtr<AFluidSource>& Source : Sources)
+	{
+		const FIntPoint Cell = FluidSubsystem->WorldToCell(Source->GetActorLocation());
+		if (!FluidSubsystem->IsValidCell(Cell.X, Cell.Y)) { continue; }
+
+		const int32 Idx = FluidSubsystem->GetCellIndex(Cell.X, Cell.Y);
+		Job->Sources.Add(Source);
+		Job->SourceCells.Add(Idx);
+		if (Source->IsActive())
+		{
+			ActiveCells.Add(Idx);
+		}
+	}
+	Job->SeedCells = ActiveCells.Num() > 0 ? MoveTemp(ActiveCells) : Job->SourceCells;
+
+	if (TownHall.IsValid())
+	{
+		const FIntPoint Cell = FluidSubsystem->WorldToCell(TownHall->GetActorLocation());
+		if (FluidSubsystem->IsValidCell(Cell.X, Cell.Y))
+		{
+			Job->TownHallCell = FluidSubsystem->GetCellIndex(Cell.X, Cell.Y);
+		}
+	}
+
+	Job->CellWorldSize = FluidSubsystem->GetCellWorldSize();
+	Job->FlatSpeed = FlatSpeed;
+	Job->SlopeSpeed = SlopeSpeed;
+	Job->FillSecondsPerUnit = FillSecondsPerUnit;
+	Job->InputsKey = InputsKey;
+
+	PendingJob = Job;
+	PendingTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]() { RunArrivalJob(*Job); });
+	LaunchedKey = InputsKey;
+	bLaunched = true;
+}
+
+void UFloodArrivalSubsystem::ApplyJob(FArrivalJob& Job)
+{
+	ArrivalTimes = MoveTemp(Job.ArrivalTimes);
+	TownHallArrivalTime = ArrivalTimes.IsValidIndex(Job.TownHallCell)
+		? ArrivalTimes[Job.TownHallCell]
+		: TNumericLimits<float>::Max();
+	FieldSources = MoveTemp(Job.Sources);
+	FieldSourceTimes = MoveTemp(Job.SourceTimes);
+
+	UpdateDebugTexture();
+	OnArrivalUpdated.Broadcast();
+}
+
+// ---------------------------------------------------------------------------
+// Worker
+// ---------------------------------------------------------------------------
+
+void UFloodArrivalSubsystem::RunArrivalJob(FArrivalJob& Job)
+{
+	if (!FloodFromSeeds(Job, Job.SeedCells, INDEX_NONE, Job.ArrivalTimes)) { return; }
+
+	// Per-source runs stop as soon as the Town Hall settles, so they only cover the near side of the map
+	Job.SourceTimes.Init(TNumericLimits<float>::Max(), Job.SourceCells.Num());
+	if (Job.TownHallCell == INDEX_NONE) { return; }
+
+	TArray<float> Scratch;
+	for (int32 S = 0; S < Job.SourceCells.Num(); ++S)
+	{
+		if (!FloodFromSeeds(Job, MakeArrayView(&Job.SourceCells[S], 1), Job.TownHallCell, Scratch)) { return; }
+		Job.SourceTimes[S] = Scratch[Job.TownHallCell];
+	}
+}
+
+bool UFloodArrivalSubsystem::FloodFromSeeds(const FArrivalJob& Job, TConstArrayView<int32> Seeds, int32 StopCell, TArray<float>& OutTimes)
+{
+	const int32 NumCells = Job.TerrainHeights.Num();
+
+	struct FOpenCell
+	{
+		float Time;
+		int32 Idx;
+		bool operator<(const FOpenCell& Other) const { return Time < Other.Time; }
+	};
+
+	OutTimes.Init(TNumericLimits<float>::Max(), NumCells);
+
+	// Pooled surface on the best path to each cell; water only has to fill above this to spill on
+	TArray<float> Level;
+	Level.SetNumUninitialized(NumCells);
+
+	TArray<FOpenCell> Open;
+	for (const int32 Seed : Seeds)
+	{
+		OutTimes[Seed] = 0.f;
+		Level[Seed] = Job.TerrainHeights[Seed];
+		Open.HeapPush({ 0.f, Seed });
+	}
+
+	int32 Settled = 0;
+	while (Open.Num() > 0)
+	{
+		FOpenCell Current;
+		Open.HeapPop(Current, EAllowShrinking::No);
+		if (Current.Time > OutTimes[Current.Idx]) { continue; }
+		if (Current.Idx == StopCell) { break; }
+
+		if ((++Settled & 1023) == 0 && Job.bCancelled) { return false; }
+
+		const int32 X = FluidGrid::CellX(Current.Idx);
+		const int32 Y = FluidGrid::CellY(Current.Idx);
+		const float FromTerrain = Job.TerrainHeights[Current.Idx];
+		const float FromLevel = Level[Current.Idx];
+		const uint8 Open4 = Job.NeighborMasks[Current.Idx];
+
+		for (int32 Dir = 0; Dir < 4; ++Dir)
+		{
+			if (!(Open4 & (1 << Dir))) { continue; }
+
+			const int32 NIdx = FluidGrid::CellIndex(X + FluidConstants::NeighborDX[Dir], Y + FluidConstants::NeighborDY[Dir]);
+			const float ToTerrain = Job.TerrainHeights[NIdx];
+
+			const float Drop = FMath::Max(0.f, FromTerrain - ToTerrain);
+			const float Rise = FMath::Max(0.f, ToTerrain - FromLevel);
+			const float Speed = Job.FlatSpeed + Job.SlopeSpeed * (Drop / Job.CellWorldSize);
+			const float Time = Current.Time + Job.CellWorldSize / Speed + Rise * Job.FillSecondsPerUnit;
+
+			if (Time >= OutTimes[NIdx]) { continue; }
+			OutTimes[NIdx] = Time;
+			Level[NIdx] = FMath::Max(FromLevel, ToTerrain);
+			Open.HeapPush({ Time, NIdx });
+		}
+	}
+
+	return !Job.bCancelled;
+}
+
+// ---------------------------------------------------------------------------
+// Debug texture
+// ---------------------------------------------------------------------------
+
+void UFloodArrivalSubsystem::UpdateDebugTexture()
+{
+	const int32 Size = FluidConstants::GridSize;
+	if (!DebugTexture)
+	{
+		DebugTexture = UTexture2D::CreateTransient(Size, Size, PF_B8G8R8A8, TEXT("FloodArrivalDebug"));
+		if (!DebugTexture) { return; }
+		DebugTexture->Filter = TF_Nearest;
+		DebugTexture->SRGB = false;
+		DebugTexture->UpdateResource();
+	}
+
+	uint8* Pixels = new uint8[Size * Size * sizeof(FColor)];
+	FColor* Colors = reinterpret_cast<FColor*>(Pixels);
+	for (int32 I = 0; I < ArrivalTimes.Num(); ++I)
+	{
+		const float Time = ArrivalTimes[I];
+		FColor& Color = Colors[FluidGrid::RowMajorIndex(I)];
+		if (Time >= TNumericLimits<float>::Max())
+		{
+			Color = FColor::Transparent;
+			continue;
+		}
+		const float Threat = 1.f - FMath::Min(Time / ThreatHorizon, 1.f);
+		Color = FColor(static_cast<uint8>(Threat * 255.f), static_cast<uint8>((1.f - Threat) * 255.f), 0, 255);
+	}
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Size, Size);
+	DebugTexture->UpdateTextureRegions(0, 1, Region, Size * sizeof(FColor), sizeof(FColor), Pixels,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] SrcData;
+			delete Regions;
+		});
+}
@@ -4,7 +4,6 @@
 #include "Fluid/FluidSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
 
 ATownHall::ATownHall()
 {
@@ -21,31 +20,48 @@ void ATownHall::BeginPlay()
 	FluidSubsystem = GetWorld()->GetSubsystem<UFluidSubsystem>();
 	BaseZ = GetActorLocation().Z;
 
-	GetWorldTimerManager().SetTimer(
-		DamageTimerHandle,
-		FTimerDelegate::CreateUObject(this, &ATownHall::CheckFluidDamage),
-		DamageCheckInterval,
-		/*bLoop=*/true
-	);
+	if (FluidSubsystem)
+	{
+		FFluidWatchDesc Desc;
+		Desc.Shape = EFluidWatchShape::Point;
+		Desc.Metric = EFluidWatchMetric::MaxSurfaceHeight;
+		Desc.Center = GetActorLocation();
+		Desc.Threshold = BaseZ;
+		Desc.bReportWhileAbove = true;
+
+		FOnFluidWatchEvent OnEvent;
+		OnEvent.BindDynamic(this, &ATownHall::OnFluidWatch);
+		FluidWatchId = FluidSubsystem->AddFluidWatch(Desc, OnEvent);
+	}
 }
 
-void ATownHall::CheckFluidDamage()
+void ATownHall::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (bDestroyed || !FluidSubsystem) { return; }
+	if (FluidSubsystem && FluidWatchId != INDEX_NONE)
+	{
+		FluidSubsystem->RemoveFluidWatch(FluidWatchId);
+		FluidWatchId = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
 
-	const float FluidHeight = FluidSubsystem->GetFluidHeightAtWorldPos(GetActorLocation());
-	const float Depth = FluidHeight - BaseZ;
+void ATownHall::OnFluidWatch(int32 WatchId, bool bAbove, float SurfaceHeight)
+{
+	if (bDestroyed || !bAbove || !FluidSubsystem) { return; }
 
+	const float Depth = SurfaceHeight - BaseZ;
 	if (Depth <= 0.f) { return; }
 
-	const float Damage = Depth * DamagePerDepthPerSecond * DamageCheckInterval;
+	const float Damage = Depth * DamagePerDepthPerSecond * FluidSubsystem->GetSimStepInterval();
 	Health = FMath::Max(0.f, Health - Damage);
 	OnHealthChanged.Broadcast(Health, MaxHealth);
 
 	if (Health <= 0.f)
 	{
 		bDestroyed = true;
-		GetWorldTimerManager().ClearTimer(DamageTimerHandle);
+		FluidSubsystem->RemoveFluidWatch(FluidWatchId);
+		FluidWatchId = INDEX_NONE;
 		OnTownDestroyed.Broadcast();
 	}
 }
@@ -73,7 +73,7 @@ void AWaveManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	GetWorldTimerManager().ClearTimer(WaveDurationHandle);
 	GetWorldTimerManager().ClearTimer(BuildPhaseHandle);
-	GetWorldTimerManager().ClearTimer(BasinCheckHandle);
+	StopBasinWatch();
 
 	Super::EndPlay(EndPlayReason);
 }
@@ -204,15 +204,27 @@ void AWaveManager::StartNextWave()
 		/*bLoop=*/false
 	);
 
-	// Start basin volume check if enabled for this wave
-	if (Config.bBasinTriggerEnabled)
+	// Watch total grid volume (or the marked basin's) if the basin trigger is enabled for this wave
+	if (Config.bBasinTriggerEnabled && FluidSubsystem)
 	{
-		GetWorldTimerManager().SetTimer(
-			BasinCheckHandle,
-			FTimerDelegate::CreateUObject(this, &AWaveManager::CheckBasinTrigger),
-			BasinCheckInterval,
-			/*bLoop=*/true
-		);
+		FFluidWatchDesc Desc;
+		Desc.Shape = EFluidWatchShape::Grid;
+		Desc.Metric = EFluidWatchMetric::TotalVolume;
+		Desc.Threshold = BasinTriggerThreshold;
+
+		FFluidBasin Basin;
+		const int32 BasinId = BasinTriggerMarker ? FluidSubsystem->GetBasinAtWorldPos(BasinTriggerMarker->GetActorLocation()) : INDEX_NONE;
+		if (FluidSubsystem->GetBasinInfo(BasinId, Basin) && !Basin.IsRoot())
+		{
+			Desc.Shape = EFluidWatchShape::Basin;
+			Desc.BasinId = BasinId;
+			Desc.Threshold = Basin.Capacity * BasinTriggerFillFraction;
+		}
+		BasinWatchThreshold = Desc.Threshold;
+
+		FOnFluidWatchEvent OnEvent;
+		OnEvent.BindDynamic(this, &AWaveManager::OnBasinWatch);
+		BasinWatchId = FluidSubsystem->AddFluidWatch(Desc, OnEvent);
 	}
 
 	UE_LOG(LogTemp, Log,
@@ -227,7 +239,7 @@ void AWaveManager::StartNextWave()
 
 void AWaveManager::OnWaveDurationElapsed()
 {
-	GetWorldTimerManager().ClearTimer(BasinCheckHandle);
+	StopBasinWatch();
 
 	if (CurrentWaveIndex + 1 >= WaveConfigs.Num())
 	{
@@ -283,30 +295,36 @@ void AWaveManager::ApplySpawnRateMultiplier(float Multiplier)
 // Basin trigger
 // ---------------------------------------------------------------------------
 
-void AWaveManager::CheckBasinTrigger()
+void AWaveManager::StopBasinWatch()
 {
-	if (bBasinTriggeredThisWave || !FluidSubsystem) { return; }
-
-	const float TotalVolume = FluidSubsystem->GetTotalFluidVolume();
-	if (TotalVolume > BasinTriggerThreshold)
+	if (FluidSubsystem && BasinWatchId != INDEX_NONE)
 	{
-		bBasinTriggeredThisWave = true;
+		FluidSubsystem->RemoveFluidWatch(BasinWatchId);
+	}
+	BasinWatchId = INDEX_NONE;
+}
+
+void AWaveManager::OnBasinWatch(int32 WatchId, bool bAbove, float TotalVolume)
+{
+	if (bBasinTriggeredThisWave || !bAbove || !WaveConfigs.IsValidIndex(CurrentWaveIndex)) { return; }
 
-		// Activate all basin sources with the current wave's multiplier applied to base rate
-		const FWaveConfig& Config = WaveConfigs[CurrentWaveIndex];
-		for (int32 i = 0; i < BasinSources.Num(); ++i)
+	bBasinTriggeredThisWave = true;
+	StopBasinWatch();
+
+	// Activate all basin sources with the current wave's multiplier applied to base rate
+	const FWaveConfig& Config = WaveConfigs[CurrentWaveIndex];
+	for (int32 i = 0; i < BasinSources.Num(); ++i)
+	{
+		if (BasinSources[i] && BaseBasinSpawnRates.IsValidIndex(i))
 		{
-			if (BasinSources[i] && BaseBasinSpawnRates.IsValidIndex(i))
-			{
-				BasinSources[i]->SetSpawnRate(BaseBasinSpawnRates[i] * Config.SpawnRateMultiplier);
-				BasinSources[i]->Activate();
-			}
+			BasinSources[i]->SetSpawnRate(BaseBasinSpawnRates[i] * Config.SpawnRateMultiplier);
+			BasinSources[i]->Activate();
 		}
-
-		UE_LOG(LogTemp, Log,
-			TEXT("AWaveManager: Basin trigger activated! Total volume %.0f > threshold %.0f"),
-			TotalVolume, BasinTriggerThreshold);
 	}
+
+	UE_LOG(LogTemp, Log,
+		TEXT("AWaveManager: Basin trigger activated! Total volume %.0f > threshold %.0f"),
+		TotalVolume, BasinWatchThreshold);
 }
 
 // ---------------------------------------------------------------------------
@@ -318,7 +336,7 @@ void AWaveManager::TriggerVictory()
 	DeactivateAllSources();
 	GetWorldTimerManager().ClearTimer(WaveDurationHandle);
 	GetWorldTimerManager().ClearTimer(BuildPhaseHandle);
-	GetWorldTimerManager().ClearTimer(BasinCheckHandle);
+	StopBasinWatch();
 	SetWaveState(EWaveState::Victory);
 
 	UE_LOG(LogTemp, Log, TEXT("AWaveManager: VICTORY — All %d waves survived!"), WaveConfigs.Num());
@@ -329,7 +347,7 @@ void AWaveManager::OnTownDestroyed()
 	DeactivateAllSources();
 	GetWorldTimerManager().ClearTimer(WaveDurationHandle);
 	GetWorldTimerManager().ClearTimer(BuildPhaseHandle);
-	GetWorldTimerManager().ClearTimer(BasinCheckHandle);
+	StopBasinWatch();
 	SetWaveState(EWaveState::Defeat);
 
 	UE_LOG(LogTemp, Warning, TEXT("AWaveManager: DEFEAT — Town Hall destroyed on wave %d."),
@@ -2,6 +2,7 @@
 
 #include "Player/BuildComponent.h"
 #include "Towers/FluidTowerBase.h"
+#include "Fluid/FluidForecastSubsystem.h"
 #include "Fluid/FluidSubsystem.h"
 #include "Fluid/FluidTypes.h"
 #include "Game/ResourceSubsystem.h"
@@ -20,6 +21,7 @@ void UBuildComponent::BeginPlay()
 	Super::BeginPlay();
 
 	FluidSubsystem = GetWorld()->GetSubsystem<UFluidSubsystem>();
+	ForecastSubsystem = GetWorld()->GetSubsystem<UFluidForecastSubsystem>();
 	if (const UGameInstance* GI = GetWorld()->GetGameInstance())
 	{
 		ResourceSubsystem = GI->GetSubsystem<UResourceSubsystem>();
@@ -43,6 +45,7 @@ void UBuildComponent::ToggleBuildMode()
 	if (!bBuildModeActive)
 	{
 		GhostMesh->SetVisibility(false);
+		ClearForecast();
 	}
 }
 
@@ -120,6 +123,7 @@ void UBuildComponent::UpdateGhostPosition()
 	{
 		bPlacementValid = false;
 		SetGhostColor(false);
+		ClearForecast();
 		return;
 	}
 
@@ -130,6 +134,7 @@ void UBuildComponent::UpdateGhostPosition()
 	{
 		bPlacementValid = false;
 		SetGhostColor(false);
+		ClearForecast();
 		return;
 	}
 
@@ -142,6 +147,47 @@ void UBuildComponent::UpdateGhostPosition()
 	// Validate
 	bPlacementValid = ValidatePlacement(PlacementLocation, Hit);
 	SetGhostColor(bPlacementValid);
+	UpdateForecast();
+}
+
+void UBuildComponent::UpdateForecast()
+{
+	if (!bForecastPlacement || !ForecastSubsystem || !bPlacementValid)
+	{
+		ClearForecast();
+		return;
+	}
+
+	const FIntPoint Cell = FluidSubsystem->WorldToCell(PlacementLocation);
+	// Rotating a levee in place changes its footprint, so rotation is part of the key
+	if (Cell == ForecastCell && SelectedTowerIndex == ForecastTowerIndex && PlacementRotation.Equals(ForecastRotation)) { return; }
+
+	const AFluidTowerBase* CDO = TowerClasses[SelectedTowerIndex].GetDefaultObject();
+	if (!CDO) { return; }
+
+	FFluidForecastEdit Edit;
+	CDO->DescribeForecastEdit(*FluidSubsystem, PlacementLocation, PlacementRotation, Edit);
+	if (Edit.IsEmpty())
+	{
+		ClearForecast();
+		return;
+	}
+
+	ForecastSubsystem->RequestForecast(Edit);
+	ForecastCell = Cell;
+	ForecastTowerIndex = SelectedTowerIndex;
+	ForecastRotation = PlacementRotation;
+}
+
+void UBuildComponent::ClearForecast()
+{
+	if (ForecastTowerIndex == INDEX_NONE) { return; }
+	if (ForecastSubsystem)
+	{
+		ForecastSubsystem->ClearForecast();
+	}
+	ForecastCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	ForecastTowerIndex = INDEX_NONE;
 }
 
 bool UBuildComponent::ValidatePlacement(const FVector& Location, const FHitResult& Hit) const
@@ -162,7 +208,7 @@ bool UBuildComponent::ValidatePlacement(const FVector& Location, const FHitResul
 	const FIntPoint Cell = FluidSubsystem->WorldToCell(Location);
 	if (!FluidSubsystem->IsValidCell(Cell.X, Cell.Y)) { return false; }
 
-	const auto& Grid = FluidSubsystem->GetGrid();
+	const TConstArrayView<FFluidCell> Grid = FluidSubsystem->GetGrid();
 	const int32 Idx = FluidSubsystem->GetCellIndex(Cell.X, Cell.Y);
 	if (Grid[Idx].FluidVolume > MaxFluidForPlacement) { return false; }
 	if (Grid[Idx].bBlocked) { return false; }
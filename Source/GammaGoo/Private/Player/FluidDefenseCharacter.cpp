@@ -86,10 +86,12 @@ void AFluidDefenseCharacter::CheckFluidDepth()
 	if (!FluidSubsystem) { return; }
 
 	const FVector Loc = GetActorLocation();
-	const float FluidSurface = FluidSubsystem->GetFluidHeightAtWorldPos(Loc);
+	const FFluidSample Sample = FluidSubsystem->SampleFluidAtWorldPos(Loc);
 	const float FeetZ = Loc.Z; // Character origin at feet
 
-	CurrentFluidDepth = FMath::Max(0.f, FluidSurface - FeetZ);
+	// Interpolated depth so wading changes smoothly across cell edges. The blended surface alone would
+	// read a dry player beside higher terrain as wading; it only caps depth for feet above the water.
+	CurrentFluidDepth = FMath::Max(0.f, FMath::Min(Sample.Depth, Sample.SurfaceHeight - FeetZ));
 	CurrentDepthTier = ComputeDepthTier(CurrentFluidDepth);
 
 	// Apply speed modifier
@@ -201,7 +203,7 @@ void AFluidDefenseCharacter::FireLanceTick()
 
 	if (GetWorld()->LineTraceSingleByChannel(Hit, CamLoc, TraceEnd, ECC_WorldStatic, Params))
 	{
-		FluidSubsystem->RemoveFluidInRadius(Hit.ImpactPoint, LanceRadius, LanceEvaporateRate * DeltaTime);
+		FluidSubsystem->QueueRemoveFluidInRadius(Hit.ImpactPoint, LanceRadius, LanceEvaporateRate * DeltaTime);
 	}
 }
 
@@ -1,6 +1,7 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 
 #include "Towers/CryoSpike.h"
+#include "Fluid/FluidForecastSubsystem.h"
 #include "Fluid/FluidSubsystem.h"
 #include "TimerManager.h"
 
@@ -23,11 +24,17 @@ void ACryoSpike::ExecuteEffect()
 	}
 }
 
+void ACryoSpike::DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const
+{
+	// Freezes on its first effect tick and holds for FreezeDuration, which covers a typical forecast
+	Fluid.GetCellsInRadius(Location, EffectRadius, OutEdit.FrozenCells);
+}
+
 void ACryoSpike::Freeze()
 {
 	if (!FluidSubsystem) { return; }
 	bFreezeActive = true;
-	FluidSubsystem->SetFrozenInRadius(GetActorLocation(), EffectRadius, true);
+	FluidSubsystem->SetFrozenInRegion(FluidRegion, true);
 
 	GetWorldTimerManager().SetTimer(
 		ThawTimerHandle,
@@ -41,7 +48,7 @@ void ACryoSpike::Thaw()
 {
 	if (!FluidSubsystem) { return; }
 	bFreezeActive = false;
-	FluidSubsystem->SetFrozenInRadius(GetActorLocation(), EffectRadius, false);
+	FluidSubsystem->SetFrozenInRegion(FluidRegion, false);
 
 	bOnCooldown = true;
 	GetWorldTimerManager().SetTimer(
@@ -1,6 +1,7 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 
 #include "Towers/EvaporatorTower.h"
+#include "Fluid/FluidForecastSubsystem.h"
 #include "Fluid/FluidSubsystem.h"
 
 AEvaporatorTower::AEvaporatorTower()
@@ -15,5 +16,12 @@ AEvaporatorTower::AEvaporatorTower()
 void AEvaporatorTower::ExecuteEffect()
 {
 	if (!FluidSubsystem || !IsAlive()) { return; }
-	FluidSubsystem->RemoveFluidInRadius(GetActorLocation(), EffectRadius, EvaporateAmount);
+	ConsumeResolvedRemoval();
+	FluidSubsystem->QueueRemoveFluidInRegion(FluidRegion, EvaporateAmount, EffectContributorId);
+}
+
+void AEvaporatorTower::DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const
+{
+	Fluid.GetCellsInRadius(Location, EffectRadius, OutEdit.RemovalCells);
+	OutEdit.RemovalPerSecond = EvaporateAmount / EffectInterval;
 }
@@ -1,10 +1,10 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 
 #include "Towers/FluidTowerBase.h"
+#include "Towers/TowerEffectSubsystem.h"
 #include "Fluid/FluidSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
 
 AFluidTowerBase::AFluidTowerBase()
 {
@@ -19,18 +19,31 @@ void AFluidTowerBase::BeginPlay()
 	Super::BeginPlay();
 
 	FluidSubsystem = GetWorld()->GetSubsystem<UFluidSubsystem>();
+	if (FluidSubsystem)
+	{
+		FluidRegion = FluidSubsystem->RegisterRegion(GetActorLocation(), EffectRadius);
+		EffectContributorId = FluidSubsystem->RegisterEffectContributor();
+	}
 
-	GetWorldTimerManager().SetTimer(
-		EffectTimerHandle,
-		FTimerDelegate::CreateUObject(this, &AFluidTowerBase::ExecuteEffect),
-		EffectInterval,
-		/*bLoop=*/true
-	);
+	TowerEffectSubsystem = GetWorld()->GetSubsystem<UTowerEffectSubsystem>();
+	if (TowerEffectSubsystem)
+	{
+		TowerEffectSubsystem->RegisterTower(this, EffectInterval);
+	}
 }
 
 void AFluidTowerBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	GetWorldTimerManager().ClearTimer(EffectTimerHandle);
+	if (TowerEffectSubsystem)
+	{
+		TowerEffectSubsystem->UnregisterTower(this);
+	}
+	if (FluidSubsystem)
+	{
+		FluidSubsystem->ReleaseRegion(FluidRegion);
+		FluidSubsystem->ReleaseEffectContributor(EffectContributorId);
+		EffectContributorId = INDEX_NONE;
+	}
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -39,6 +52,24 @@ void AFluidTowerBase::ExecuteEffect()
 	// Override in subclasses
 }
 
+void AFluidTowerBase::RecordFluidRemoved(float Volume)
+{
+	if (Volume <= 0.f) { return; }
+	TotalFluidRemoved += Volume;
+	if (TowerEffectSubsystem)
+	{
+		TowerEffectSubsystem->ReportFluidRemoved(Volume);
+	}
+}
+
+float AFluidTowerBase::ConsumeResolvedRemoval()
+{
+	if (!FluidSubsystem) { return 0.f; }
+	const float Removed = FluidSubsystem->ConsumeRemovedVolume(EffectContributorId);
+	RecordFluidRemoved(Removed);
+	return Removed;
+}
+
 void AFluidTowerBase::ApplyDamage(float DamageAmount)
 {
 	if (DamageAmount <= 0.f || Health <= 0.f) { return; }
@@ -52,6 +83,5 @@ void AFluidTowerBase::ApplyDamage(float DamageAmount)
 
 void AFluidTowerBase::OnDestroyed_Internal()
 {
-	GetWorldTimerManager().ClearTimer(EffectTimerHandle);
 	Destroy();
 }
@@ -1,6 +1,7 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 
 #include "Towers/LeveeWall.h"
+#include "Fluid/FluidForecastSubsystem.h"
 #include "Fluid/FluidSubsystem.h"
 #include "Fluid/FluidTypes.h"
 
@@ -19,22 +20,34 @@ void ALeveeWall::BeginPlay()
 
 	if (!FluidSubsystem) { return; }
 
-	// Compute occupied cells along the wall's forward axis
-	const FVector Location = GetActorLocation();
-	const FVector Forward = GetActorForwardVector();
+	ComputeWallCells(*FluidSubsystem, GetActorLocation(), GetActorForwardVector(), OccupiedCells);
+	BlockCells(true);
+}
+
+void ALeveeWall::ComputeWallCells(const UFluidSubsystem& Fluid, const FVector& Location, const FVector& Forward, TArray<FIntPoint>& OutCells) const
+{
+	// Occupied cells along the wall's forward axis
 	const float CellSize = FluidConstants::DefaultCellWorldSize;
 
 	for (int32 I = 0; I < WallLength; ++I)
 	{
 		const FVector CellWorldPos = Location + Forward * (I - WallLength / 2) * CellSize;
-		const FIntPoint Cell = FluidSubsystem->WorldToCell(CellWorldPos);
-		if (FluidSubsystem->IsValidCell(Cell.X, Cell.Y))
+		const FIntPoint Cell = Fluid.WorldToCell(CellWorldPos);
+		if (Fluid.IsValidCell(Cell.X, Cell.Y))
 		{
-			OccupiedCells.Add(Cell);
+			OutCells.Add(Cell);
 		}
 	}
+}
 
-	BlockCells(true);
+void ALeveeWall::DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const
+{
+	TArray<FIntPoint> Cells;
+	ComputeWallCells(Fluid, Location, Rotation.Vector(), Cells);
+	for (const FIntPoint& Cell : Cells)
+	{
+		OutEdit.BlockedCells.Add(Fluid.GetCellIndex(Cell.X, Cell.Y));
+	}
 }
 
 void ALeveeWall::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -49,7 +62,7 @@ void ALeveeWall::ExecuteEffect()
 
 	// Pressure damage: max fluid height differential across all occupied cells vs neighbors
 	float MaxPressure = 0.f;
-	const TArray<FFluidCell>& Grid = FluidSubsystem->GetGrid();
+	const TConstArrayView<FFluidCell> Grid = FluidSubsystem->GetGrid();
 
 	for (const FIntPoint& Cell : OccupiedCells)
 	{
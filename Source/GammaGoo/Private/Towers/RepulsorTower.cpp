@@ -15,5 +15,5 @@ ARepulsorTower::ARepulsorTower()
 void ARepulsorTower::ExecuteEffect()
 {
 	if (!FluidSubsystem || !IsAlive()) { return; }
-	FluidSubsystem->ApplyRadialForceInRadius(GetActorLocation(), EffectRadius, PushStrength);
+	FluidSubsystem->QueueRadialForceInRegion(FluidRegion, PushStrength);
 }
@@ -1,6 +1,7 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 
 #include "Towers/SiphonTower.h"
+#include "Fluid/FluidForecastSubsystem.h"
 #include "Fluid/FluidSubsystem.h"
 #include "Game/ResourceSubsystem.h"
 #include "Engine/World.h"
@@ -18,12 +19,10 @@ void ASiphonTower::ExecuteEffect()
 {
 	if (!FluidSubsystem || !IsAlive()) { return; }
 
-	// Measure fluid before and after to compute actual removal
-	const float VolumeBefore = FluidSubsystem->GetTotalFluidVolume();
-	FluidSubsystem->RemoveFluidInRadius(GetActorLocation(), EffectRadius, DrainAmount);
-	const float VolumeAfter = FluidSubsystem->GetTotalFluidVolume();
+	// Pay out for what the previous drain actually took, then queue the next one
+	const float Removed = ConsumeResolvedRemoval();
+	FluidSubsystem->QueueRemoveFluidInRegion(FluidRegion, DrainAmount, EffectContributorId);
 
-	const float Removed = VolumeBefore - VolumeAfter;
 	if (Removed > 0.f)
 	{
 		if (UResourceSubsystem* Res = GetGameInstance()->GetSubsystem<UResourceSubsystem>())
@@ -32,3 +31,9 @@ void ASiphonTower::ExecuteEffect()
 		}
 	}
 }
+
+void ASiphonTower::DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const
+{
+	Fluid.GetCellsInRadius(Location, EffectRadius, OutEdit.RemovalCells);
+	OutEdit.RemovalPerSecond = DrainAmount / EffectInterval;
+}
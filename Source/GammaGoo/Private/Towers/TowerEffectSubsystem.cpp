@@ -0,0 +1,142 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+
+#include "Towers/TowerEffectSubsystem.h"
+#include "Towers/FluidTowerBase.h"
+#include "Fluid/FluidSubsystem.h"
+
+void UTowerEffectSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FluidSubsystem = Collection.InitializeDependency<UFluidSubsystem>();
+	if (FluidSubsystem)
+	{
+		PreStepHandle = FluidSubsystem->OnPreStep().AddUObject(this, &UTowerEffectSubsystem::OnFluidPreStep);
+	}
+}
+
+void UTowerEffectSubsystem::Deinitialize()
+{
+	if (FluidSubsystem)
+	{
+		FluidSubsystem->OnPreStep().Remove(PreStepHandle);
+	}
+	PreStepHandle.Reset();
+	FluidSubsystem = nullptr;
+	Groups.Empty();
+	PendingChanges.Empty();
+
+	Super::Deinitialize();
+}
+
+void UTowerEffectSubsystem::RegisterTower(AFluidTowerBase* Tower, float Interval)
+{
+	if (!Tower) { return; }
+
+	// Groups may be mid-iteration; a new group would reallocate the array under the sweep
+	if (bSweeping)
+	{
+		PendingChanges.Add({ Tower, Tower->GetClass(), Interval, /*bAdd=*/true });
+		return;
+	}
+	AddTower(Tower, Interval);
+}
+
+void UTowerEffectSubsystem::UnregisterTower(AFluidTowerBase* Tower)
+{
+	if (!Tower) { return; }
+
+	if (bSweeping)
+	{
+		PendingChanges.Add({ Tower, Tower->GetClass(), 0.f, /*bAdd=*/false });
+		return;
+	}
+	RemoveTower(Tower->GetClass(), Tower);
+}
+
+void UTowerEffectSubsystem::AddTower(AFluidTowerBase* Tower, float Interval)
+{
+	const UClass* Class = Tower->GetClass();
+	FTowerGroup* Group = Groups.FindByPredicate([Class](const FTowerGroup& G) { return G.Class == Class; });
+	if (!Group)
+	{
+		Group = &Groups.AddDefaulted_GetRef();
+		Group->Class = Class;
+	}
+
+	FTowerEntry& Entry = Group->Entries.AddDefaulted_GetRef();
+	Entry.Tower = Tower;
+	Entry.Interval = FMath::Max(Interval, KINDA_SMALL_NUMBER);
+}
+
+void UTowerEffectSubsystem::RemoveTower(const UClass* Class, const TWeakObjectPtr<AFluidTowerBase>& Tower)
+{
+	for (FTowerGroup& Group : Groups)
+	{
+		if (Group.Class != Class) { continue; }
+
+		// Stable removal keeps effect order deterministic
+		Group.Entries.RemoveAll([Tower](const FTowerEntry& Entry) { return Entry.Tower == Tower; });
+		return;
+	}
+}
+
+int32 UTowerEffectSubsystem::GetRegisteredTowerCount() const
+{
+	int32 Count = 0;
+	for (const FTowerGroup& Group : Groups)
+	{
+		Count += Group.Entries.Num();
+	}
+	return Count;
+}
+
+void UTowerEffectSubsystem::OnFluidPreStep(float StepSeconds)
+{
+	bSweeping = true;
+
+	for (FTowerGroup& Group : Groups)
+	{
+		// Advance all timers for the group first, then run the due towers back to back.
+		// Effects can destroy towers, so nothing below touches Entries after the sweep.
+		DueTowers.Reset();
+
+		for (FTowerEntry& Entry : Group.Entries)
+		{
+			// Capped at one interval, so a hitch that runs several steps back to back fires each tower
+			// at most once per step instead of bursting through a backlog
+			Entry.Accumulator = FMath::Min(Entry.Accumulator + StepSeconds, Entry.Interval);
+			if (Entry.Accumulator < Entry.Interval) { continue; }
+
+			Entry.Accumulator -= Entry.Interval;
+			if (AFluidTowerBase* Tower = Entry.Tower.Get())
+			{
+				DueTowers.Add(Tower);
+			}
+		}
+
+		for (AFluidTowerBase* Tower : DueTowers)
+		{
+			if (IsValid(Tower) && Tower->IsAlive())
+			{
+				Tower->ExecuteEffect();
+			}
+		}
+	}
+
+	bSweeping = false;
+
+	// A removed tower may already be destroyed; weak pointers still compare equal by object slot
+	for (const FPendingChange& Change : PendingChanges)
+	{
+		if (!Change.bAdd)
+		{
+			RemoveTower(Change.Class, Change.Tower);
+		}
+		else if (AFluidTowerBase* Tower = Change.Tower.Get())
+		{
+			AddTower(Tower, Change.Interval);
+		}
+	}
+	PendingChanges.Reset();
+}
@@ -4,6 +4,7 @@
 #include "Game/WaveManager.h"
 #include "Game/ResourceSubsystem.h"
 #include "Game/TownHall.h"
+#include "Towers/TowerEffectSubsystem.h"
 #include "Player/FluidDefenseCharacter.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
@@ -49,6 +50,12 @@ void UFluidSiegeHUD::CacheReferences()
 		}
 	}
 
+	// Tower Effect Subsystem — World subsystem
+	if (!CachedTowerEffectSubsystem)
+	{
+		CachedTowerEffectSubsystem = World->GetSubsystem<UTowerEffectSubsystem>();
+	}
+
 	// Resource Subsystem — GameInstance subsystem
 	if (!CachedResourceSubsystem)
 	{
@@ -68,7 +75,7 @@ void UFluidSiegeHUD::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
 	// Re-cache if any reference is lost (e.g., late spawn)
-	if (!CachedWaveManager || !CachedTownHall || !CachedResourceSubsystem)
+	if (!CachedWaveManager || !CachedTownHall || !CachedResourceSubsystem || !CachedTowerEffectSubsystem)
 	{
 		CacheReferences();
 	}
@@ -140,6 +147,13 @@ void UFluidSiegeHUD::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 			FString::Printf(TEXT("%.0f"), CachedResourceSubsystem->GetCurrency())));
 	}
 
+	// --- Fluid destroyed text: "Drained 12345" ---
+	if (FluidDestroyedText && CachedTowerEffectSubsystem)
+	{
+		FluidDestroyedText->SetText(FText::FromString(
+			FString::Printf(TEXT("Drained %.0f"), CachedTowerEffectSubsystem->GetTotalFluidRemoved())));
+	}
+
 	// --- Town Hall health bar and text ---
 	if (CachedTownHall)
 	{
@@ -0,0 +1,90 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// FFluidArena holds the fluid sim's per-cell planes in one cache-line aligned block, optionally
+// backed by huge pages on Linux. Released blocks are pooled, so the next level load reuses them.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Where a plane lives inside an FFluidArena. Returned by AddPlane, resolved by ConstructPlane. */
+template <typename T>
+struct TFluidArenaPlane
+{
+	SIZE_T Offset = 0;
+	int32 Num = 0;
+};
+
+/**
+ * One allocation carved into planes. Lay every plane out with AddPlane, Commit once, then
+ * ConstructPlane each. Every plane starts on its own cache line, so aligned SIMD loads never
+ * straddle two planes. Elements must be trivially destructible; the arena never runs destructors.
+ */
+class GAMMAGOO_API FFluidArena
+{
+public:
+	static constexpr SIZE_T Alignment = 64;
+
+	FFluidArena() = default;
+	~FFluidArena() { Release(); }
+	FFluidArena(const FFluidArena&) = delete;
+	FFluidArena& operator=(const FFluidArena&) = delete;
+
+	template <typename T>
+	TFluidArenaPlane<T> AddPlane(int32 Num)
+	{
+		static_assert(alignof(T) <= Alignment, "Plane element alignment exceeds the arena's");
+		static_assert(std::is_trivially_destructible_v<T>, "The arena never runs destructors");
+		check(!Block);
+
+		TFluidArenaPlane<T> Plane;
+		Plane.Offset = LayoutSize;
+		Plane.Num = Num;
+		LayoutSize = Align(LayoutSize + sizeof(T) * Num, Alignment);
+		return Plane;
+	}
+
+	/**
+	 * Allocates the laid-out size, taking the pooled block if it is big enough. Huge pages are a
+	 * request: they are only used on Linux, and it falls back to normal pages if the kernel refuses.
+	 */
+	void Commit(bool bUseHugePages);
+
+	/** Default-constructs the plane's elements and returns a view onto them. */
+	template <typename T>
+	TArrayView<T> ConstructPlane(const TFluidArenaPlane<T>& Plane)
+	{
+		check(Block && Plane.Offset + sizeof(T) * Plane.Num <= LayoutSize);
+		T* Data = reinterpret_cast<T*>(Block + Plane.Offset);
+		DefaultConstructItems<T>(Data, Plane.Num);
+		return TArrayView<T>(Data, Plane.Num);
+	}
+
+	/**
+	 * Hands the block to the pool (or frees it if the pool is full) and clears the layout. Every view
+	 * from ConstructPlane is dead afterwards; non-shipping builds poison the block to catch stale readers.
+	 */
+	void Release();
+
+	bool IsCommitted() const { return Block != nullptr; }
+	SIZE_T GetSize() const { return LayoutSize; }
+
+private:
+	/** One parked block. Kept across worlds so a level load does not go back to the OS. */
+	struct FBlock
+	{
+		uint8* Data = nullptr;
+		SIZE_T Size = 0;
+		bool bHugePages = false;
+	};
+
+	static FBlock AllocateBlock(SIZE_T Size, bool bUseHugePages);
+	static void FreeBlock(const FBlock& Block);
+
+	static FCriticalSection PoolLock;
+	static FBlock PooledBlock;
+
+	uint8* Block = nullptr;
+	SIZE_T BlockSize = 0;
+	bool bBlockHugePages = false;
+	SIZE_T LayoutSize = 0;
+};
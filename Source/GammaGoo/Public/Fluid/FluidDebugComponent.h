@@ -0,0 +1,40 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// UFluidDebugComponent draws the fluid debug view as one vertex-coloured dynamic mesh.
+// UFluidSubsystem fills it from the grid in a single pass per sim step.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "FluidDebugComponent.generated.h"
+
+/** One flat, coloured quad in the debug mesh. Built on the game thread, expanded on the render thread. */
+struct FFluidDebugQuad
+{
+	FVector3f Center = FVector3f::ZeroVector;
+	float HalfExtent = 0.f;
+	FColor Color = FColor::White;
+};
+
+UCLASS(ClassGroup = (Fluid))
+class GAMMAGOO_API UFluidDebugComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+public:
+	UFluidDebugComponent();
+
+	/** Replaces the drawn quads. Ownership of the array moves to the render thread. */
+	void SetQuads(TArray<FFluidDebugQuad>&& Quads);
+
+	/** World-space box covering the fluid grid. Used for culling only. */
+	void SetDrawBounds(const FBox& InBounds);
+
+	// --- UPrimitiveComponent interface ---
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	virtual void GetUsedMaterials(TArray<UMaterialInterface*>& OutMaterials, bool bGetDebugMaterials = false) const override;
+
+private:
+	FBox DrawBounds = FBox(ForceInit);
+};
@@ -0,0 +1,129 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// UFluidForecastSubsystem answers "where will the fluid be in N seconds, with and without this placement?"
+// Both runs step a captured copy of the sim on a worker; a new request cancels the one in flight.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "FluidForecastSubsystem.generated.h"
+
+class UFluidSubsystem;
+class UTexture2D;
+struct FFluidSimState;
+
+/** Hypothetical change applied to the forecast copy. Entries are grid cell indices. */
+struct FFluidForecastEdit
+{
+	TArray<int32> BlockedCells;
+	TArray<int32> FrozenCells;
+
+	/** Drained every step at RemovalPerSecond, shared out by depth like RemoveFluidInRadius. */
+	TArray<int32> RemovalCells;
+	float RemovalPerSecond = 0.f;
+
+	bool IsEmpty() const
+	{
+		return BlockedCells.Num() == 0 && FrozenCells.Num() == 0 && (RemovalCells.Num() == 0 || RemovalPerSecond <= 0.f);
+	}
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFluidForecastReady);
+
+UCLASS()
+class GAMMAGOO_API UFluidForecastSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- UWorldSubsystem interface ---
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Forecasts ForecastHorizon seconds ahead with and without Edit. Supersedes any request in flight. */
+	void RequestForecast(const FFluidForecastEdit& Edit);
+
+	/** Cancels the request in flight and drops the current result. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Forecast")
+	void ClearForecast();
+
+	/** A new result has been applied. Fires on the game thread. */
+	UPROPERTY(BlueprintAssignable, Category = "Fluid|Forecast")
+	FOnFluidForecastReady OnForecastReady;
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Forecast")
+	bool HasForecast() const { return DepthDeltas.Num() > 0; }
+
+	/** Mean depth change (with edit minus without) over the texel containing WorldPos. 0 off-grid or with no result. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Forecast")
+	float GetForecastDepthDeltaAtWorldPos(FVector WorldPos) const;
+
+	/** R32F, one texel per ForecastCellsPerTexel^2 cells: signed mean depth change. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Forecast")
+	UTexture2D* GetForecastDeltaTexture() const { return DeltaTexture; }
+
+protected:
+	/** Simulated seconds per forecast. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Forecast", meta = (ClampMin = "1.0"))
+	float ForecastHorizon = 30.f;
+
+	/** A captured state is reused this long, so a moving ghost only re-runs the edited half. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Forecast", meta = (ClampMin = "0.0"))
+	float SnapshotMaxAge = 1.f;
+
+	/** How often finished jobs are collected (seconds). */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Forecast", meta = (ClampMin = "0.02"))
+	float PollInterval = 0.05f;
+
+private:
+	/** Owns everything the worker touches. The snapshot is shared read-only between jobs. */
+	struct FForecastJob
+	{
+		TSharedPtr<const FFluidSimState, ESPMode::ThreadSafe> Snapshot;
+		FFluidForecastEdit Edit;
+		int32 NumSteps = 0;
+
+		/** Filled only when the snapshot has no baseline run yet. */
+		bool bNeedsBaseline = false;
+		TArray<float> BaselineDepths;
+		TArray<float> EditedDepths;
+
+		std::atomic<bool> bCancelled = false;
+	};
+
+	static void RunForecastJob(FForecastJob& Job);
+
+	/** Steps State NumSteps times, draining Edit's removal before each step. False if cancelled. */
+	static bool RunHeadless(FFluidSimState& State, const FFluidForecastEdit* Edit, int32 NumSteps, const std::atomic<bool>& bCancelled);
+
+	/** Mean depth per texel. */
+	static void CoarsenDepths(const FFluidSimState& State, TArray<float>& OutDepths);
+
+	/** Timer: applies a finished job. */
+	void PollForecast();
+	void ApplyJob(FForecastJob& Job);
+	void UpdateDeltaTexture();
+	void CancelPendingJob();
+
+	UPROPERTY()
+	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UTexture2D> DeltaTexture = nullptr;
+
+	TSharedPtr<const FFluidSimState, ESPMode::ThreadSafe> Snapshot;
+	double SnapshotTime = 0.0;
+
+	/** Unedited run from Snapshot. Empty until the first job on this snapshot completes. */
+	TArray<float> BaselineDepths;
+
+	TSharedPtr<FForecastJob, ESPMode::ThreadSafe> PendingJob;
+	UE::Tasks::FTask PendingTask;
+
+	TArray<float> DepthDeltas;
+
+	FTimerHandle PollHandle;
+};
@@ -0,0 +1,130 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// Flow step kernel shared by the live sim and headless copies of it (forecasts).
+// Works only on caller-owned buffers, so it is safe to run off the game thread.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fluid/FluidTypes.h"
+
+/** Tuning the kernel reads. Captured from UFluidSubsystem so headless runs match the live sim. */
+struct FFluidStepParams
+{
+	float FlowRate = FluidConstants::DefaultFlowRate;
+	float OscillationClamp = FluidConstants::DefaultOscillationClamp;
+	float VelocityDamping = FluidConstants::DefaultVelocityDamping;
+};
+
+/** Tuning for RelaxPools. */
+struct FFluidPoolParams
+{
+	/** Blocks with any cell shallower than this (or frozen, or blocked) sit the pass out. */
+	float MinDepth = FluidConstants::DefaultLakeMinDepth;
+
+	/**
+	 * Same gates as lake detection: a block whose surface spans more than this, or that holds a cell
+	 * flowing faster than MaxSpeed, is a sheet or river rather than a pool and sits the pass out.
+	 * Two blocks only exchange when their combined surface range is also within MaxSurfaceRange.
+	 */
+	float MaxSurfaceRange = FluidConstants::DefaultLakeFlatness;
+	float MaxSpeed = FluidConstants::DefaultLakeMaxSpeed;
+	float Relaxation = FluidConstants::DefaultPoolRelaxation;
+
+	/** Level L uses blocks of 2^(L+1) cells per side. */
+	int32 NumLevels = FluidConstants::DefaultPoolSolveLevels;
+};
+
+/**
+ * Buffers for one flow step. Non-owning. The delta accumulators must be zero on entry and are
+ * left zero on exit. AwakeTiles selects the tiles to step and is replaced with next step's set.
+ */
+struct FFluidStepContext
+{
+	TArrayView<FFluidCell> Grid;
+	TConstArrayView<uint8> NeighborMasks;
+	TArrayView<float> FluidDeltas;
+	TArrayView<FVector2D> FlowVelocityDeltas;
+	TBitArray<>* AwakeTiles = nullptr;
+
+	/** Scratch: awake tiles plus the ring that can receive their transfers. */
+	TBitArray<>* StepTiles = nullptr;
+
+	/**
+	 * Optional: frozen / blocked cells per tile (TilesPerSide^2, row-major). Must be exact when given;
+	 * tiles with none run a pass-1 variant without those checks. Empty runs the general variant everywhere.
+	 */
+	TConstArrayView<uint16> TileFrozenCounts;
+	TConstArrayView<uint16> TileBlockedCounts;
+
+	/**
+	 * Optional: cells a lake holds out of the step, and how many each tile has. Held cells neither send
+	 * nor receive; the caller closes the open bits their neighbours hold toward them. Tiles made only
+	 * of held cells are skipped by both passes.
+	 */
+	const TBitArray<>* HeldCells = nullptr;
+	TConstArrayView<uint16> TileHeldCounts;
+
+	// Optional outputs, skipped when null or empty
+	TBitArray<>* WetTileMask = nullptr;
+	TArrayView<float> TileVolumes;
+	TArrayView<uint8> StepCost;
+};
+
+namespace FluidKernel
+{
+	/**
+	 * Pass 1 accumulates transfers for awake tiles, each through the variant its tile counts allow;
+	 * pass 2 applies them over awake tiles and their ring.
+	 */
+	GAMMAGOO_API void StepFlow(const FFluidStepParams& Params, FFluidStepContext& Ctx);
+
+	/**
+	 * Coarse-grid correction for deep pools. The cell step moves a surface disturbance one cell per
+	 * step; this moves volume directly between adjacent fully submerged, flat, still blocks, coarsest
+	 * level first, so a wide pool settles in a handful of passes. Flowing water is left to the cell step.
+	 * Exactly conserves volume. Uses only Grid, HeldCells (blocks holding one sit out), AwakeTiles (tiles
+	 * it changes are woken) and TileVolumes (kept in step when provided).
+	 */
+	GAMMAGOO_API void RelaxPools(const FFluidPoolParams& Params, FFluidStepContext& Ctx);
+
+	/**
+	 * Sets bBlocked on (X,Y) and keeps the open bits its neighbours hold toward it in sync, and the
+	 * tile's blocked count when TileBlockedCounts is given.
+	 */
+	GAMMAGOO_API void SetBlocked(TArrayView<FFluidCell> Grid, TArrayView<uint8> NeighborMasks, int32 X, int32 Y, bool bBlock,
+		TArrayView<uint16> TileBlockedCounts = TArrayView<uint16>());
+
+	/** Rebuilds both per-tile counts from scratch. */
+	GAMMAGOO_API void CountTileFlags(TConstArrayView<FFluidCell> Grid, TArray<uint16>& OutFrozenCounts, TArray<uint16>& OutBlockedCounts);
+}
+
+/**
+ * Self-contained copy of the sim, captured with UFluidSubsystem::CaptureSimState. Steps exactly
+ * like the live grid, minus tower effects, with each source's inflow held at its capture rate.
+ */
+struct GAMMAGOO_API FFluidSimState
+{
+	FFluidStepParams Params;
+	float StepSeconds = FluidConstants::DefaultSimStepRate;
+
+	TArray<FFluidCell> Grid;
+	TArray<uint8> NeighborMasks;
+	TBitArray<> AwakeTiles;
+
+	/** Volume added to each cell every step, parallel arrays. */
+	TArray<int32> InflowCells;
+	TArray<float> InflowVolumes;
+
+	/**
+	 * Adds inflow, then runs one flow step. Scratch buffers and tile counts are built on first use,
+	 * so frozen / blocked edits must be made before the first Step.
+	 */
+	void Step();
+
+private:
+	TArray<float> FluidDeltas;
+	TArray<FVector2D> FlowVelocityDeltas;
+	TBitArray<> StepTiles;
+	TArray<uint16> TileFrozenCounts;
+	TArray<uint16> TileBlockedCounts;
+};
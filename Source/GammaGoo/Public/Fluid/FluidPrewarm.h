@@ -0,0 +1,49 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// AFluidPrewarm describes a level's starting flood: sources run headlessly for Duration seconds
+// while the level loads. UFluidSubsystem runs it after the terrain bake and caches the result.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "FluidPrewarm.generated.h"
+
+/** One inflow that only exists during the pre-warm run. */
+USTRUCT(BlueprintType)
+struct GAMMAGOO_API FFluidPrewarmSource
+{
+	GENERATED_BODY()
+
+	/** Relative to the pre-warm actor. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Prewarm", meta = (MakeEditWidget))
+	FVector Location = FVector::ZeroVector;
+
+	/** Footprint radius (world units). 0 injects into the single cell under Location. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Prewarm", meta = (ClampMin = "0.0"))
+	float Radius = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Prewarm", meta = (ClampMin = "0.0"))
+	float RatePerSecond = 100.f;
+};
+
+/** Place at most one per level. The first one found is used. */
+UCLASS()
+class GAMMAGOO_API AFluidPrewarm : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AFluidPrewarm();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fluid|Prewarm")
+	TArray<FFluidPrewarmSource> Sources;
+
+	/** Simulated seconds run before the level starts. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fluid|Prewarm", meta = (ClampMin = "0.0"))
+	float Duration = 60.f;
+
+	bool HasWork() const { return Duration > 0.f && Sources.Num() > 0; }
+
+	/** Hash of everything above in world space. Part of the pre-warm cache key. */
+	uint64 ComputeDescriptionHash() const;
+};
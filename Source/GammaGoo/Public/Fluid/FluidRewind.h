@@ -0,0 +1,97 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// FFluidRewindBuffer keeps the last few seconds of fluid state for rewinds and replays. Steps are
+// stored as tile-major XOR deltas against the previous step, with a keyframe every few steps.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fluid/FluidTypes.h"
+
+/** One reconstructed step, indexed like the grid. */
+struct FFluidRewindFrame
+{
+	int32 Step = INDEX_NONE;
+	TArray<float> FluidVolumes;
+	TArray<FVector2f> FlowVelocities;
+};
+
+/**
+ * Bounded history of FluidVolume and FlowVelocity. Terrain, frozen and blocked state are owned
+ * by the actors that set them, so they are not recorded.
+ *
+ * Each frame lists the tiles that changed, then for each changed plane of a tile the XOR of every
+ * cell's bits against the previous step, with a 2-bit tag per cell saying how many low bytes
+ * follow (0, 2, 3 or 4). Sleeping tiles cost one bit. Settled cells cost two. A keyframe is the same
+ * encoding against an all-zero grid, so dry tiles are skipped there too. Velocities are stored at
+ * float precision.
+ *
+ * Frames are grouped per keyframe, and the oldest group is dropped as a unit once the rest still
+ * cover MaxSteps or the bytes exceed MaxBytes. Memory therefore stays within MaxBytes plus one
+ * group.
+ */
+class GAMMAGOO_API FFluidRewindBuffer
+{
+public:
+	/** Clears the history if the limits change. */
+	void Configure(int32 InMaxSteps, int32 InKeyframeInterval, SIZE_T InMaxBytes);
+
+	/** Appends Step. A step that does not follow the newest one starts a fresh keyframe. */
+	void Record(int32 Step, TConstArrayView<FFluidCell> Grid);
+
+	/** Decodes Step from its keyframe forward. False if Step is outside the history. */
+	bool Reconstruct(int32 Step, FFluidRewindFrame& OutFrame) const;
+
+	/** Drops every frame after Step, so the next Record(Step + 1) continues from it. */
+	void TruncateAfter(int32 Step);
+
+	void Reset();
+
+	bool IsEmpty() const { return Groups.Num() == 0; }
+	int32 GetOldestStep() const { return IsEmpty() ? INDEX_NONE : Groups[0].FirstStep; }
+	int32 GetNewestStep() const { return IsEmpty() ? INDEX_NONE : Groups.Last().FirstStep + Groups.Last().FrameEnds.Num() - 1; }
+
+	/** Encoded bytes currently held, excluding the two working planes. */
+	SIZE_T GetEncodedSize() const { return EncodedBytes; }
+
+private:
+	static constexpr int32 NumPlanes = 3; // FluidVolume, FlowVelocity.X, FlowVelocity.Y
+	static constexpr int32 TileCells = FluidConstants::TileSize * FluidConstants::TileSize;
+
+	/** Float bits per plane in tile-major order: tile (row-major), then cell within the tile (row-major). */
+	struct FPlanes
+	{
+		TArray<uint32> Words[NumPlanes];
+
+		void Init();
+	};
+
+	/** Frames FirstStep.. onward. Frame 0 is the keyframe; FrameEnds[I] is where frame I stops in Bytes. */
+	struct FGroup
+	{
+		int32 FirstStep = 0;
+		TArray<uint8> Bytes;
+		TArray<int32> FrameEnds;
+	};
+
+	static void Gather(TConstArrayView<FFluidCell> Grid, FPlanes& Out);
+	static void Encode(const FPlanes& Previous, const FPlanes& Current, TArray<uint8>& Out);
+	static void Decode(TConstArrayView<uint8> Bytes, FPlanes& InOut);
+
+	/** Rebuilds the planes for Step into Out. Step must be inside the history. */
+	void DecodeStep(int32 Step, FPlanes& Out) const;
+	void EvictOldGroups();
+
+	TArray<FGroup> Groups;
+
+	/** The newest recorded step, the base the next delta is taken against. */
+	FPlanes Last;
+	FPlanes Scratch;
+
+	/** Bytes of the last dropped group, reused by the next keyframe. */
+	TArray<uint8> SpareBytes;
+
+	int32 MaxSteps = 0;
+	int32 KeyframeInterval = 1;
+	SIZE_T MaxBytes = 0;
+	SIZE_T EncodedBytes = 0;
+};
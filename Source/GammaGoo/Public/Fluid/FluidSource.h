@@ -1,6 +1,6 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
 // AFluidSource is a placeable actor that injects fluid into the subsystem grid.
-// Activated and deactivated by AWaveManager to control wave flow.
+// Registers as a continuous inflow boundary while active; AWaveManager toggles it per wave.
 
 #pragma once
 
@@ -10,6 +10,7 @@
 
 class UFluidSubsystem;
 class USceneComponent;
+class UCurveFloat;
 
 UCLASS(BlueprintType, Blueprintable)
 class GAMMAGOO_API AFluidSource : public AActor
@@ -29,21 +30,32 @@ public:
 	void Deactivate();
 
 	UFUNCTION(BlueprintCallable, Category = "Fluid|Source")
-	void SetSpawnRate(float NewRate) { SpawnRate = NewRate; }
+	void SetSpawnRate(float NewRate);
 
 	UFUNCTION(BlueprintPure, Category = "Fluid|Source")
 	float GetSpawnRate() const { return SpawnRate; }
 
+	UFUNCTION(BlueprintPure, Category = "Fluid|Source")
+	bool IsActive() const { return bActive; }
+
 protected:
-	/** Volume of fluid added per SpawnInterval. */
+	/** Volume of fluid added per SpawnInterval. Delivered continuously at SpawnRate / SpawnInterval per second. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Source")
 	float SpawnRate = 10.f;
 
-	/** How often fluid is injected (seconds). */
+	/** Period SpawnRate is measured over (seconds). No longer a timer; only sets the per-second rate. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Source",
 		meta = (ClampMin = "0.016"))
 	float SpawnInterval = 0.1f;
 
+	/** Inflow footprint radius (world units). 0 injects into the single cell under the source. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Source", meta = (ClampMin = "0.0"))
+	float InflowRadius = 0.f;
+
+	/** Optional rate multiplier over seconds since activation. Unset means a constant rate. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Source")
+	TObjectPtr<UCurveFloat> InflowSchedule = nullptr;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Source")
 	bool bActiveOnBeginPlay = true;
 
@@ -51,13 +63,11 @@ protected:
 	bool bActive = false;
 
 private:
-	void SpawnFluid();
-
-	FTimerHandle SpawnTimerHandle;
+	float GetInflowRatePerSecond() const { return SpawnRate / SpawnInterval; }
 
 	UPROPERTY()
 	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
 
-	/** Cached grid coordinate. Computed once in BeginPlay — source must not move. */
-	FIntPoint CachedCellCoord = FIntPoint(INDEX_NONE, INDEX_NONE);
+	/** Subsystem inflow registration while active. The footprint is resolved once — source must not move. */
+	int32 InflowId = INDEX_NONE;
 };
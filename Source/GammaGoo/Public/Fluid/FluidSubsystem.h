@@ -6,10 +6,112 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "Tasks/Task.h"
+#include <atomic>
 #include "Fluid/FluidTypes.h"
+#include "Fluid/FluidArena.h"
+#include "Fluid/FluidRewind.h"
 #include "FluidSubsystem.generated.h"
 
 class UTextureRenderTarget2D;
+class UFluidDebugComponent;
+class ALandscapeProxy;
+class UCurveFloat;
+struct FFluidSimState;
+struct FFluidStepParams;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFluidTerrainBakeProgress, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFluidTerrainReady);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnFluidPreStep, float /*StepSeconds*/);
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnFluidWatchEvent, int32, WatchId, bool, bAbove, float, Value);
+
+/**
+ * Precomputed circular footprint. Per-cell falloff (1 at the centre, 0 at the rim) and
+ * outward unit direction are stored alongside the index so effects never recompute them.
+ */
+struct FFluidRegion
+{
+	TArray<int32> Cells;
+	TArray<float> Falloff;
+	TArray<FVector2D> Directions;
+	FIntRect CellRect;
+	int32 Serial = 0;
+};
+
+/**
+ * Continuous inflow boundary condition. Rate is spread over the footprint by Weights (which sum
+ * to 1) and integrated every SimStep, optionally scaled by Schedule sampled at ElapsedSeconds.
+ */
+struct FFluidInflow
+{
+	TArray<int32> Cells;
+	TArray<float> Weights;
+	FIntRect CellRect;
+	float RatePerSecond = 0.f;
+	TWeakObjectPtr<const UCurveFloat> Schedule;
+	float ElapsedSeconds = 0.f;
+};
+
+/** The readable part of one cell, as FFluidGridSnapshot holds it. */
+struct FFluidSnapshotCell
+{
+	float SurfaceHeight = 0.f;
+	float Depth = 0.f;
+	FVector2f FlowVelocity = FVector2f::ZeroVector;
+	bool bFrozen = false;
+};
+
+/**
+ * Immutable copy of the grid after one SimStep, indexed like the grid. Holders keep it alive through
+ * the shared pointer, so it is safe to read from worker threads and outlives the subsystem's planes.
+ */
+struct FFluidGridSnapshot
+{
+	TArray<FFluidSnapshotCell> Cells;
+};
+
+/**
+ * Connected, near-flat pool solved as one surface. Interior cells (all four neighbours in the lake)
+ * are held out of the flow step and their water is carried in InteriorVolume; only the rim trades
+ * with the rest of the grid. Every cell of a lake is wet, so the level is (volume + TerrainSum) / N.
+ */
+struct FFluidLake
+{
+	TArray<int32> Cells;
+	TArray<int32> RimCells;
+	TArray<int32> InteriorCells;
+
+	/** Tiles holding rim cells. A lake only needs levelling when one of them stepped. */
+	TArray<int32> RimTiles;
+
+	double TerrainSum = 0.0;
+	double RimTerrainSum = 0.0;
+	float MaxTerrain = 0.f;
+
+	/** Authoritative volume of the interior. The grid's copy is only rewritten when the level drifts. */
+	double InteriorVolume = 0.0;
+	float Level = 0.f;
+
+	/** Level the interior cells were last written at. */
+	float InteriorLevel = 0.f;
+
+	/** Set when formed, grown or written to directly: levels and rewrites the interior next step. */
+	bool bDirty = true;
+};
+
+/** Registered watch plus the footprint resolved at registration. */
+struct FFluidWatch
+{
+	FFluidWatchDesc Desc;
+	FOnFluidWatchEvent OnEvent;
+	TArray<int32> Cells;
+	FIntRect TileRect;
+	bool bAbove = false;
+
+	/** Forces one evaluation after registration even if the area is asleep. */
+	bool bNeedsEvaluation = true;
+};
 
 UCLASS()
 class GAMMAGOO_API UFluidSubsystem : public UWorldSubsystem
@@ -22,15 +124,50 @@ public:
 	virtual void Deinitialize() override;
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
+	// --- Terrain bake ---
+
+	/** Fraction of queued terrain traces completed [0,1]. Broadcast every frame while the bake runs. */
+	UPROPERTY(BlueprintAssignable, Category = "Fluid|Terrain")
+	FOnFluidTerrainBakeProgress OnTerrainBakeProgress;
+
+	/** Terrain is baked and the sim has started. */
+	UPROPERTY(BlueprintAssignable, Category = "Fluid|Terrain")
+	FOnFluidTerrainReady OnTerrainReady;
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Terrain")
+	bool IsTerrainReady() const { return bTerrainReady; }
+
+	/** Fires at the start of every SimStep, before any flow is computed. Mutations made here land in this step. */
+	FOnFluidPreStep& OnPreStep() { return PreStepDelegate; }
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Terrain")
+	float GetTerrainBakeProgress() const;
+
+	/** True while the level's AFluidPrewarm run is stepping on a worker. The sim starts once it lands. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Terrain")
+	bool IsPrewarming() const { return PrewarmJob.IsValid(); }
+
+	/** Fraction of the pre-warm steps completed [0,1]. 1 when no pre-warm is running. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Terrain")
+	float GetPrewarmProgress() const;
+
+	/**
+	 * Re-traces terrain for every cell whose centre lies inside Bounds (XY only).
+	 * Traces run async; each result updates TerrainHeight and wakes the cell's sim tile.
+	 * Call after towers, destructibles or barriers change the ground.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Terrain")
+	void RebakeTerrainInBounds(FBox Bounds);
+
 	// --- Public Gameplay API ---
 
 	/** Returns fluid surface height (TerrainHeight + FluidVolume) at any world position. */
 	UFUNCTION(BlueprintCallable, Category = "Fluid")
 	float GetFluidHeightAtWorldPos(FVector WorldPos) const;
 
-	/** Reduces FluidVolume in a sphere footprint. Used by towers, heat lance, siphons. */
+	/** Reduces FluidVolume in a sphere footprint. Used by towers, heat lance, siphons. Returns the volume actually removed. */
 	UFUNCTION(BlueprintCallable, Category = "Fluid")
-	void RemoveFluidInRadius(FVector WorldPos, float Radius, float Amount);
+	float RemoveFluidInRadius(FVector WorldPos, float Radius, float Amount);
 
 	/** Adds fluid volume directly to a specific cell. Called by AFluidSource each tick. */
 	UFUNCTION(BlueprintCallable, Category = "Fluid")
@@ -52,10 +189,165 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Fluid")
 	void SetBlockedAtCell(int32 X, int32 Y, bool bBlock);
 
-	/** Returns sum of all FluidVolume across the grid. Used by AWaveManager. */
+	/** Returns sum of all FluidVolume across the grid. */
 	UFUNCTION(BlueprintCallable, Category = "Fluid")
 	float GetTotalFluidVolume() const;
 
+	/** Seconds of simulated time per SimStep. */
+	UFUNCTION(BlueprintPure, Category = "Fluid")
+	float GetSimStepInterval() const { return SimStepRate; }
+
+	// --- Threshold watches ---
+
+	/**
+	 * Registers a threshold watch. OnEvent fires from the sim step when the metric crosses
+	 * the threshold (with hysteresis on the way down). Returns an id for RemoveFluidWatch.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Watch")
+	int32 AddFluidWatch(const FFluidWatchDesc& Desc, FOnFluidWatchEvent OnEvent);
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Watch")
+	void RemoveFluidWatch(int32 WatchId);
+
+	/**
+	 * Bilinear surface height, depth and flow plus the surface gradient and normal at WorldPos.
+	 * Unlike GetFluidHeightAtWorldPos this is continuous across cell edges.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fluid")
+	FFluidSample SampleFluidAtWorldPos(FVector WorldPos) const;
+
+	// --- Region handles ---
+
+	/** Precomputes the footprint of a circle. Release with ReleaseRegion when the owner goes away. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Region")
+	FFluidRegionHandle RegisterRegion(FVector Center, float Radius);
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Region")
+	void ReleaseRegion(UPARAM(ref) FFluidRegionHandle& Handle);
+
+	/** RemoveFluidInRadius over a registered region. Returns the volume actually removed. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Region")
+	float RemoveFluidInRegion(const FFluidRegionHandle& Handle, float Amount);
+
+	/** ApplyForceInRadius over a registered region. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Region")
+	void ApplyForceInRegion(const FFluidRegionHandle& Handle, FVector2D Force);
+
+	/** ApplyRadialForceInRadius over a registered region. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Region")
+	void ApplyRadialForceInRegion(const FFluidRegionHandle& Handle, float Strength);
+
+	/** SetFrozenInRadius over a registered region. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Region")
+	void SetFrozenInRegion(const FFluidRegionHandle& Handle, bool bFreeze);
+
+	// --- Coalesced effects ---
+	// Queued requests accumulate into per-cell effect planes and are resolved together in one
+	// pass at the start of the next SimStep, so the result no longer depends on call order.
+	// Where several removals overlap a cell that can't cover them all, each gets a proportional share.
+
+	/** Ids for attributing queued removals. Release when the contributor goes away. */
+	int32 RegisterEffectContributor();
+	void ReleaseEffectContributor(int32 ContributorId);
+
+	/** Volume credited to ContributorId by removals resolved since the last call. Resets to zero. */
+	float ConsumeRemovedVolume(int32 ContributorId);
+
+	/** Queues RemoveFluidInRegion. The removed volume is credited to ContributorId once resolved. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Effects")
+	void QueueRemoveFluidInRegion(const FFluidRegionHandle& Handle, float Amount, int32 ContributorId = -1);
+
+	/** Queues RemoveFluidInRadius. The removed volume is credited to ContributorId once resolved. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Effects")
+	void QueueRemoveFluidInRadius(FVector WorldPos, float Radius, float Amount, int32 ContributorId = -1);
+
+	/** Queues ApplyForceInRegion. Forces from every contributor sum in the force plane. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Effects")
+	void QueueForceInRegion(const FFluidRegionHandle& Handle, FVector2D Force);
+
+	/** Queues ApplyRadialForceInRegion. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Effects")
+	void QueueRadialForceInRegion(const FFluidRegionHandle& Handle, float Strength);
+
+	/** Queues an injection into one cell, applied after this step's removals. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Effects")
+	void QueueInflowAtCell(int32 X, int32 Y, float Amount);
+
+	// --- Inflow boundaries ---
+	// Sources register a rate instead of injecting lumps on their own timers. Every SimStep adds
+	// Rate * step seconds through the inflow plane, so injection runs at the sim's cadence.
+
+	/**
+	 * Registers continuous inflow over a circle (Radius 0 = the cell under Center). Schedule, if
+	 * set, is sampled at seconds since registration and multiplies the rate. Returns an id for
+	 * SetInflowRate / ReleaseInflow.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Inflow")
+	int32 RegisterInflow(FVector Center, float Radius, float RatePerSecond, const UCurveFloat* Schedule = nullptr);
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Inflow")
+	void SetInflowRate(int32 InflowId, float RatePerSecond);
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Inflow")
+	void ReleaseInflow(int32 InflowId);
+
+	// --- Headless copies ---
+
+	/** Snapshot for stepping the sim off the game thread. Inflows are frozen at their current rate. */
+	void CaptureSimState(FFluidSimState& OutState) const;
+
+	/** Cell indices inside the circle, as RegisterRegion would resolve them. */
+	void GetCellsInRadius(FVector Center, float Radius, TArray<int32>& OutCells) const;
+
+	// --- Rewind ---
+
+	/** Steps run since the sim started. The state after step N is recorded as N. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Rewind")
+	int32 GetSimStepCount() const { return SimStepCount; }
+
+	/** Oldest / newest recorded step, INDEX_NONE while the history is empty. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Rewind")
+	int32 GetRewindOldestStep() const { return RewindBuffer.GetOldestStep(); }
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Rewind")
+	int32 GetRewindNewestStep() const { return RewindBuffer.GetNewestStep(); }
+
+	/**
+	 * Puts the grid's fluid back to how it was after Step and drops the history past it. Terrain,
+	 * frozen and blocked cells stay as they are now. False if Step has left the history.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Rewind")
+	bool RewindToStep(int32 Step);
+
+	/** RewindToStep for the step Seconds of sim time ago. */
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Rewind")
+	bool RewindSeconds(float Seconds);
+
+	/** Decodes a past step without touching the grid, for replays. False if Step is not recorded. */
+	bool ReconstructRewindStep(int32 Step, FFluidRewindFrame& OutFrame) const { return RewindBuffer.Reconstruct(Step, OutFrame); }
+
+	// --- Batched queries ---
+	// One call for many actors. Positions resolve to cells four at a time; results match the
+	// scalar queries, with off-grid positions reading as 0 / zero velocity.
+
+	void GetFluidHeightsAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<float> OutHeights) const;
+	void GetFluidDepthsAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<float> OutDepths) const;
+	void GetFlowVelocitiesAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<FVector2D> OutVelocities) const;
+
+	void SampleFluidAtWorldPositions(TConstArrayView<FVector> Positions, TArrayView<FFluidSample> OutSamples) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Batch", meta = (DisplayName = "Get Fluid Heights At World Positions"))
+	void K2_GetFluidHeightsAtWorldPositions(const TArray<FVector>& Positions, TArray<float>& OutHeights) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Batch", meta = (DisplayName = "Get Fluid Depths At World Positions"))
+	void K2_GetFluidDepthsAtWorldPositions(const TArray<FVector>& Positions, TArray<float>& OutDepths) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Batch", meta = (DisplayName = "Get Flow Velocities At World Positions"))
+	void K2_GetFlowVelocitiesAtWorldPositions(const TArray<FVector>& Positions, TArray<FVector2D>& OutVelocities) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Fluid|Batch", meta = (DisplayName = "Sample Fluid At World Positions"))
+	void K2_SampleFluidAtWorldPositions(const TArray<FVector>& Positions, TArray<FFluidSample>& OutSamples) const;
+
 	// --- Grid coordinate helpers ---
 
 	UFUNCTION(BlueprintCallable, Category = "Fluid|Grid")
@@ -70,17 +362,71 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Fluid|Grid")
 	int32 GetCellIndex(int32 X, int32 Y) const;
 
-	/** Read-only grid access for rendering systems. */
-	const TArray<FFluidCell>& GetGrid() const { return Grid; }
+	/**
+	 * Read-only grid access on the game thread. Do not keep the view past the current call: the planes
+	 * live in a pooled arena block that is handed to the next world on Deinitialize, and SimStep writes
+	 * them in place. Copy what you need, or hold GetGridSnapshot instead.
+	 */
+	TConstArrayView<FFluidCell> GetGrid() const { return Grid; }
+
+	/** Shared copy of the grid as of the last SimStep, built on first request each step. Safe to hold and read off-thread. */
+	TSharedRef<const FFluidGridSnapshot, ESPMode::ThreadSafe> GetGridSnapshot() const;
+
+	/** Per-cell open-neighbour bits (FluidConstants::NeighborDX order). Same rules as GetGrid. */
+	TConstArrayView<uint8> GetNeighborMasks() const { return NeighborMasks; }
+
+	/** Bumped whenever terrain heights or blocked cells change. Lets derived fields detect staleness cheaply. */
+	int32 GetTerrainRevision() const { return TerrainRevision; }
+
+	FVector GetGridWorldOrigin() const { return GridWorldOrigin; }
+	float GetCellWorldSize() const { return CellWorldSize; }
 
 	/** Called by AFluidSurfaceRenderer to register render targets for GPU updates. */
 	void SetRenderTargets(UTextureRenderTarget2D* HeightRT, UTextureRenderTarget2D* FlowRT);
 
+	UTextureRenderTarget2D* GetHeightRenderTarget() const { return HeightRenderTarget; }
+	UTextureRenderTarget2D* GetFlowRenderTarget() const { return FlowRenderTarget; }
+
+	/** One bit per tile (TilesPerSide^2, row-major), set if any cell held fluid after the last step. */
+	const TBitArray<>& GetWetTileMask() const { return WetTileMask; }
+
+	/** One bit per tile, set if the tile will be simulated next step. Sleeping tiles are skipped entirely. */
+	const TBitArray<>& GetAwakeTileMask() const { return AwakeTiles; }
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Lakes")
+	int32 GetLakeCount() const { return Lakes.Num(); }
+
+	// --- Depression tree ---
+
+	/** Leaf basin under WorldPos, INDEX_NONE off-grid or before the terrain is baked. Walk Parent for larger ones. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Basins")
+	int32 GetBasinAtWorldPos(FVector WorldPos) const;
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Basins")
+	bool GetBasinInfo(int32 BasinId, FFluidBasin& OutBasin) const;
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Basins")
+	int32 GetBasinCount() const { return Basins.Num(); }
+
+	/** Fluid currently on the basin's cells. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Basins")
+	float GetBasinVolume(int32 BasinId) const;
+
+	/**
+	 * Seconds until the basin fills to its spill height at InflowPerSecond, assuming nothing leaves it.
+	 * 0 if already full, -1 for a root or a non-positive inflow.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Basins")
+	float EstimateBasinFillSeconds(int32 BasinId, float InflowPerSecond) const;
+
+	/** Appends every cell of the basin, including all leaves under a merged one. */
+	void GetBasinCells(int32 BasinId, TArray<int32>& OutCells) const;
+
 protected:
 	// --- Grid state ---
 
-	UPROPERTY(VisibleAnywhere, Category = "Fluid|Grid")
-	TArray<FFluidCell> Grid;
+	/** Cells in FluidGrid order. Lives in Arena with the other per-cell planes. */
+	TArrayView<FFluidCell> Grid;
 
 	/** World-space position of cell [0,0]. Grid is centered on world origin by default. */
 	UPROPERTY(EditAnywhere, Category = "Fluid|Grid")
@@ -103,23 +449,250 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Fluid|Tuning", meta = (ClampMin = "0.001", ClampMax = "1.0"))
 	float SimStepRate = FluidConstants::DefaultSimStepRate;
 
+	/**
+	 * Terrain source for the bake. Auto reads Landscape heightmaps where they cover a cell
+	 * and traces the rest, so mesh-built levels behave exactly as before.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Terrain")
+	EFluidTerrainSource TerrainSource = EFluidTerrainSource::Auto;
+
+	/** Reduction applied to the heightmap samples inside each cell. Max keeps thin ridges watertight. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Terrain")
+	EFluidTerrainFilter LandscapeFilter = EFluidTerrainFilter::Mean;
+
+	/** Async terrain traces issued per frame. The engine runs each frame's batch across worker threads. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Tuning", meta = (ClampMin = "64"))
+	int32 TerrainBakeBatchSize = FluidConstants::DefaultTerrainBakeBatchSize;
+
+	// --- Lakes ---
+
+	/** Collapse settled pools into lakes: the interior leaves the cell step and the pool re-levels at once. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Lakes")
+	bool bEnableLakes = true;
+
+	UPROPERTY(EditAnywhere, Category = "Fluid|Lakes", meta = (ClampMin = "0.05"))
+	float LakeDetectInterval = FluidConstants::DefaultLakeDetectInterval;
+
+	/** Highest minus lowest surface allowed across a whole lake, so a sloped sheet never chains into one. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Lakes", meta = (ClampMin = "0.0"))
+	float LakeFlatness = FluidConstants::DefaultLakeFlatness;
+
+	/** Only stagnant water collapses: cells with a faster FlowVelocity stay with the cell sim. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Lakes", meta = (ClampMin = "0.0"))
+	float LakeMaxSpeed = FluidConstants::DefaultLakeMaxSpeed;
+
+	UPROPERTY(EditAnywhere, Category = "Fluid|Lakes", meta = (ClampMin = "0.0"))
+	float LakeMinDepth = FluidConstants::DefaultLakeMinDepth;
+
+	UPROPERTY(EditAnywhere, Category = "Fluid|Lakes", meta = (ClampMin = "2"))
+	int32 LakeMinCells = FluidConstants::DefaultLakeMinCells;
+
+	// --- Pool solve ---
+
+	/** Periodic coarse-grid pass that settles deep pools in a few passes instead of one cell per step. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Pools")
+	bool bEnablePoolSolve = true;
+
+	UPROPERTY(EditAnywhere, Category = "Fluid|Pools", meta = (ClampMin = "0.0"))
+	float PoolSolveInterval = FluidConstants::DefaultPoolSolveInterval;
+
+	/** Block sizes 4, 8, ... up to 2^(Levels+1) cells per side. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Pools", meta = (ClampMin = "1", ClampMax = "6"))
+	int32 PoolSolveLevels = FluidConstants::DefaultPoolSolveLevels;
+
+	/** Fraction of the surface gap between two blocks closed per pass. Above 0.25 can overshoot. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Pools", meta = (ClampMin = "0.0", ClampMax = "0.25"))
+	float PoolRelaxation = FluidConstants::DefaultPoolRelaxation;
+
+	// --- Rewind ---
+
+	/** Record every step into the rewind history. Costs one grid read and the encode per step. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Rewind")
+	bool bEnableRewind = false;
+
+	UPROPERTY(EditAnywhere, Category = "Fluid|Rewind", meta = (ClampMin = "0.0"))
+	float RewindHistorySeconds = FluidConstants::DefaultRewindHistorySeconds;
+
+	/** Steps between keyframes. Longer saves memory; reconstructing a step decodes up to this many frames. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Rewind", meta = (ClampMin = "1"))
+	int32 RewindKeyframeInterval = FluidConstants::DefaultRewindKeyframeInterval;
+
+	/** Cap on the encoded history. The oldest second is dropped early if a busy flood exceeds it. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Rewind", meta = (ClampMin = "1"))
+	int32 RewindBudgetMB = FluidConstants::DefaultRewindBudgetMB;
+
+	// --- Memory ---
+
+	/** Back the per-cell planes with huge pages (Linux only). Pays off on servers running large grids. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Memory")
+	bool bArenaHugePages = false;
+
 	// --- Debug ---
 
 	UPROPERTY(EditAnywhere, Category = "Fluid|Debug")
 	bool bDebugDraw = false;
 
+	/** What the debug view shows. Overridden by fluid.DebugDrawMode when that is >= 0. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Debug")
+	EFluidDebugMode DebugDrawMode = EFluidDebugMode::Depth;
+
 private:
+	/** Loads the cooked cache or bakes from the level. The sim starts once every cell has a height. */
 	void BakeTerrainHeights();
+
+	/** Bakes without the cache: Landscape cells are sampled inline, everything else is queued for traces. */
+	void BakeTerrainFromLevel();
+
+	/** Reduces the heightmap samples under cell (X,Y) with LandscapeFilter. False if no landscape covers it. */
+	bool SampleLandscapeCell(TConstArrayView<const ALandscapeProxy*> Landscapes, int32 X, int32 Y, int32 SamplesPerAxis, float& OutHeight) const;
+	void IssueTerrainBakeBatch();
+	void OnTerrainTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void OnTerrainRebakeTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void FinishTerrainBake();
+
+	/** Broadcasts the end of loading and starts the sim. Runs after the bake, or after the pre-warm lands. */
+	void CompleteTerrainSetup();
+	void StartSimulation();
+
+	/**
+	 * Runs the level's AFluidPrewarm, from its cache if the key matches, otherwise on a worker.
+	 * True when a worker run was launched and CompleteTerrainSetup waits for it.
+	 */
+	bool StartPrewarm();
+
+	/** Timer: applies a finished pre-warm run. */
+	void PollPrewarm();
+	void ApplyPrewarmVolumes(TConstArrayView<float> RowMajorVolumes);
+	uint64 ComputePrewarmKey(const FFluidSimState& State, uint64 DescriptionHash) const;
+
+	/** Fills terrain and neighbour masks from the level's cooked cache. False if missing or stale. */
+	bool TryLoadTerrainCache();
+	void SaveTerrainCache() const;
+	uint64 ComputeTerrainGeometryHash() const;
+
+	/** Console: fluid.RebuildTerrainCache. Re-bakes from the level and rewrites the cache. */
+	void RebuildTerrainCache();
+
+	/** Recomputes every cell's open-neighbour bits from bounds and bBlocked. */
+	void RebuildNeighborMasks();
+
 	void SimStep();
-	void DrawDebugFluid() const;
+	FFluidStepParams GetStepParams() const;
+
+	/** Resolves the cells of a circle, with falloff and direction. Shared by RegisterRegion and the *InRadius calls. */
+	void BuildRegion(FVector Center, float Radius, FFluidRegion& OutRegion) const;
+	const FFluidRegion* FindRegion(const FFluidRegionHandle& Handle) const;
+
+	float RemoveFluidInCells(const FFluidRegion& Region, float Amount);
+	void ApplyForceInCells(const FFluidRegion& Region, FVector2D Force);
+	void ApplyRadialForceInCells(const FFluidRegion& Region, float Strength);
+	void SetFrozenInCells(const FFluidRegion& Region, bool bFreeze);
+
+	/** Adds Idx to this step's touched-cell list the first time any plane writes it. */
+	void MarkEffectCell(int32 Idx);
+	void QueueRemovalInCells(TConstArrayView<int32> Cells, const FIntRect& CellRect, float Amount, int32 ContributorId);
+
+	/** Adds every registered inflow's share for this step to the inflow plane. */
+	void ApplyInflows();
+
+	/** Falloff-weighted cells under a source. Falls back to the cell under Center when Radius misses every centre. */
+	void BuildInflowFootprint(FVector Center, float Radius, FFluidInflow& OutInflow) const;
+
+	/** Fused pass: removal, inflow and force planes applied to every touched cell, then contributors credited. */
+	void ResolveEffects();
+
+	/**
+	 * Flood fill over deep, flat, connected cells outside any lake. A component that meets a lake at
+	 * its level grows that lake; one that meets several dissolves them so the next sweep joins them.
+	 */
+	void DetectLakes();
+
+	/** Pools each touched lake's rim with its interior volume and re-levels the rim. Dissolves lakes that ran dry. */
+	void LevelLakes();
+
+	/** Classifies Cells into rim and interior and holds the interior. Cells must already carry LakeIndex. */
+	void BuildLake(int32 LakeIndex);
+
+	/** Writes the interior back to the grid at its exact volume and releases it. */
+	void ReleaseLakeInterior(FFluidLake& Lake);
+	void DissolveLake(int32 LakeIndex);
+	void DissolveAllLakes();
+
+	/** Dissolves the lake holding Idx, if any, before its frozen / blocked / terrain state changes. */
+	void DissolveLakeAtCell(int32 Idx);
+
+	/** Books a direct volume write to a held cell into its lake. Call after every write outside the step. */
+	void NoteHeldCellWrite(int32 Idx, float Change);
+	void SetCellHeld(int32 Idx, bool bHold);
+
+	/** Rebuilds the depression tree from terrain heights. */
+	void BuildBasins();
+
+	/** Evaluates every watch against this step's state and fires crossings after the sweep. */
+	void EvaluateWatches();
+	float ComputeWatchMetric(const FFluidWatch& Watch) const;
+
+	/** Resolves Count (<= 4) positions to cell indices four lanes at once, in double like WorldToCell. Off-grid positions get INDEX_NONE. */
+	void ResolveCellIndices4(const FVector* Positions, int32 Count, int32 OutIndices[4]) const;
+
+	/** Shared body of the batched queries: Read(Cell) per resolved position, Fallback off-grid. */
+	template <typename TValue, typename TReadFunc>
+	void GatherCellValues(TConstArrayView<FVector> Positions, TArrayView<TValue> Out, const TValue& Fallback, TReadFunc&& Read) const;
+
+	/** Wakes every tile touching the cell rect, grown by one cell so neighbours across a tile edge wake too. */
+	void WakeCellsInRect(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY);
+	void WakeCell(int32 X, int32 Y) { WakeCellsInRect(X, Y, X, Y); }
+
+	/** Rebuilds the batched debug mesh from the grid in one pass. */
+	void UpdateDebugView();
+	bool IsDebugDrawEnabled() const;
+	EFluidDebugMode GetActiveDebugMode() const;
 
 	FTimerHandle SimTimerHandle;
 
+	// --- Terrain bake state ---
+	FTraceDelegate TerrainTraceDelegate;
+	FTraceDelegate TerrainRebakeDelegate;
+	FTimerHandle TerrainBakeHandle;
+	TArray<FIntPoint> TerrainBakeQueue;
+	int32 TerrainBakeNextIssue = 0;
+	int32 TerrainBakeCompleted = 0;
+	bool bTerrainReady = false;
+
+	/** True when the current terrain was baked from the level rather than the cache, so it is worth saving. */
+	bool bTerrainNeedsCacheSave = false;
+
+	int32 TerrainRevision = 0;
+
+	// --- Pre-warm ---
+	struct FPrewarmJob
+	{
+		TSharedPtr<FFluidSimState, ESPMode::ThreadSafe> State;
+		uint64 Key = 0;
+		int32 NumSteps = 0;
+		std::atomic<int32> StepsDone = 0;
+		std::atomic<bool> bCancelled = false;
+	};
+
+	TSharedPtr<FPrewarmJob, ESPMode::ThreadSafe> PrewarmJob;
+	UE::Tasks::FTask PrewarmTask;
+	FTimerHandle PrewarmPollHandle;
+
+	/**
+	 * Per-cell bit per direction (FluidConstants::NeighborDX order): neighbour is in bounds
+	 * and not blocked. Lets the flow step skip the bounds and blocked checks entirely.
+	 */
+	TArrayView<uint8> NeighborMasks;
+
+	/** Frozen / blocked cells per tile. Lets the step pick a cheaper kernel for tiles with none. */
+	TArray<uint16> TileFrozenCounts;
+	TArray<uint16> TileBlockedCounts;
+
 	/** Per-step accumulator parallel to Grid. Avoids double-buffer allocation. */
-	TArray<float> FluidDeltas;
+	TArrayView<float> FluidDeltas;
 
 	/** Per-step velocity accumulator: tracks directional outflow for FlowVelocity derivation. */
-	TArray<FVector2D> FlowVelocityDeltas;
+	TArrayView<FVector2D> FlowVelocityDeltas;
 
 	/** Writes fluid grid data to Height and Flow render targets for the surface renderer. */
 	void UpdateRenderTargets();
@@ -130,5 +703,111 @@ private:
 	UPROPERTY()
 	TObjectPtr<UTextureRenderTarget2D> FlowRenderTarget = nullptr;
 
+	/** Rebuilt in SimStep pass 2. See GetWetTileMask. */
+	TBitArray<> WetTileMask;
+
+	/** Sum of FluidVolume per tile, refreshed in pass 2 for every stepped tile. Feeds whole-grid watches. */
+	TArray<float> TileVolumes;
+
+	TSparseArray<FFluidRegion> Regions;
+	int32 NextRegionSerial = 1;
+
+	// --- Effect planes (parallel to Grid, zero outside the touched cells) ---
+
+	/** Volume asked of each cell by this step's removals. Holds the granted fraction during crediting. */
+	TArrayView<float> RemovalPlane;
+	TArrayView<float> InflowPlane;
+	TArrayView<FVector2D> ForcePlane;
+	TBitArray<> EffectCellMask;
+	TArray<int32> EffectCells;
+
+	/** One queued removal. Its cells live in RemovalRequestCells[CellStart, CellStart + CellCount). */
+	struct FRemovalRequest
+	{
+		int32 CellStart = 0;
+		int32 CellCount = 0;
+		float Amount = 0.f;
+		int32 ContributorId = INDEX_NONE;
+	};
+	TArray<FRemovalRequest> RemovalRequests;
+	TArray<int32> RemovalRequestCells;
+
+	/** Per-cell ask of each request, parallel to RemovalRequestCells. Filled in ResolveEffects. */
+	TArray<float> RemovalRequestAsks;
+
+	/** Removed volume awaiting ConsumeRemovedVolume, per contributor id. */
+	TSparseArray<float> ContributorRemoved;
+
+	/**
+	 * Released ids whose slots are freed after the next ResolveEffects. Removals they queued this step
+	 * still resolve, but the credit is dropped instead of going to whichever tower reuses the slot.
+	 */
+	TArray<int32> ReleasedContributors;
+
+	TSparseArray<FFluidInflow> Inflows;
+
+	/** Built lazily by GetGridSnapshot, dropped whenever the grid moves on. */
+	mutable TSharedPtr<const FFluidGridSnapshot, ESPMode::ThreadSafe> GridSnapshot;
+
+	TArray<FFluidLake> Lakes;
+
+	/** Index into Lakes per cell, INDEX_NONE outside any lake. */
+	TArray<int32> CellLakeIds;
+
+	/** Lake interior cells, out of the flow step, and their count per tile. */
+	TBitArray<> LakeHeldCells;
+	TArray<uint16> TileHeldCounts;
+	float LakeDetectAccumulator = 0.f;
+	float PoolSolveAccumulator = 0.f;
+
+	int32 SimStepCount = 0;
+	FFluidRewindBuffer RewindBuffer;
+
+	/** Leaves first (ids below NumLeafBasins), then merged nodes in spill order. */
+	TArray<FFluidBasin> Basins;
+	int32 NumLeafBasins = 0;
+
+	/** The two basins each merged node joins, indexed by BasinId - NumLeafBasins. */
+	TArray<FIntPoint> BasinChildren;
+
+	/** Leaf basin per cell. */
+	TArray<int32> CellBasinIds;
+
+	/** Cells grouped by leaf: leaf L owns BasinCells[BasinCellStart[L], BasinCellStart[L + 1]). */
+	TArray<int32> BasinCellStart;
+	TArray<int32> BasinCells;
+
+	/** A rebake changed terrain; the tree is rebuilt before the first step after its traces all land. */
+	bool bBasinsDirty = false;
+
+	/** Rebake traces issued and not yet returned. */
+	int32 RebakeTracesPending = 0;
+
+	FOnFluidPreStep PreStepDelegate;
+
+	TMap<int32, FFluidWatch> Watches;
+	int32 NextWatchId = 1;
+
+	/**
+	 * Tiles to simulate next step. A tile stays awake while its cells keep changing; its
+	 * neighbours wake with it since their edge cells see the change. Mutations wake explicitly.
+	 */
+	TBitArray<> AwakeTiles;
+
+	/** Scratch for SimStep: awake tiles plus the ring that can receive their transfers. */
+	TBitArray<> StepTiles;
+
+	/** Per-cell work done in the last SimStep (1 + neighbours evaluated). Only filled in StepCost debug mode. */
+	TArrayView<uint8> CellStepCost;
+
+	/** Owns Grid and every per-cell plane above as one aligned block. Pooled across worlds. */
+	FFluidArena Arena;
+
+	/** Transient host for the debug mesh. Created the first time debug draw is enabled. */
+	UPROPERTY()
+	TObjectPtr<UFluidDebugComponent> DebugComponent = nullptr;
+
 	IConsoleVariable* CVarDebugDraw = nullptr;
+	IConsoleVariable* CVarDebugDrawMode = nullptr;
+	IConsoleObject* CmdRebuildTerrainCache = nullptr;
 };
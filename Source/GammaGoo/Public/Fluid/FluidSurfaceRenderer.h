@@ -9,10 +9,23 @@
 #include "FluidSurfaceRenderer.generated.h"
 
 class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
 class UTextureRenderTarget2D;
 class UFluidSubsystem;
 class UMaterialInstanceDynamic;
 
+/** How the fluid surface geometry is produced. */
+UENUM(BlueprintType)
+enum class EFluidSurfaceMode : uint8
+{
+	/** One subdivided plane covering the whole grid (FluidPlaneMesh). */
+	StaticPlane		UMETA(DisplayName = "Static Plane"),
+
+	/** Camera-centred quadtree of instanced patches. Patches over dry tiles are culled. */
+	Clipmap			UMETA(DisplayName = "Clipmap")
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class GAMMAGOO_API AFluidSurfaceRenderer : public AActor
 {
@@ -22,6 +35,7 @@ public:
 	AFluidSurfaceRenderer();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 protected:
 	/** The plane mesh that gets displaced by the material. */
@@ -40,9 +54,54 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Rendering")
 	TObjectPtr<UMaterialInterface> FluidMaterial;
 
+	// --- Clipmap mode ---
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Fluid|Rendering")
+	EFluidSurfaceMode SurfaceMode = EFluidSurfaceMode::StaticPlane;
+
+	/** Instanced patches used in Clipmap mode. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid|Rendering|Clipmap")
+	TObjectPtr<UInstancedStaticMeshComponent> PatchInstances;
+
+	/**
+	 * Square, centred, subdivided patch mesh (e.g. 32x32 quads with skirts). The material must
+	 * derive its height UVs from world position using the GridOrigin/GridWorldSize parameters.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Rendering|Clipmap")
+	TObjectPtr<UStaticMesh> PatchMesh;
+
+	/** Edge length of PatchMesh in world units at scale 1. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Rendering|Clipmap", meta = (ClampMin = "1.0"))
+	float PatchMeshWorldSize = 100.f;
+
+	/** Smallest patch edge, in cells. Must be a power of two. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Rendering|Clipmap", meta = (ClampMin = "1"))
+	int32 MinPatchCells = 8;
+
+	/** A node splits while camera distance < node edge length * this factor. Higher = more detail. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Rendering|Clipmap", meta = (ClampMin = "0.5"))
+	float LODDistanceFactor = 1.5f;
+
+	/** How often the patch layout is rebuilt (seconds). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid|Rendering|Clipmap", meta = (ClampMin = "0.016"))
+	float PatchUpdateInterval = 0.1f;
+
 private:
 	void CreateRenderTargets();
 
+	/** Rebuilds the quadtree around the camera and pushes patch transforms to PatchInstances. */
+	void UpdatePatches();
+	void EmitPatches(int32 CellX, int32 CellY, int32 SizeCells, const FVector2D& ViewXY, TArray<FTransform>& OutTransforms) const;
+	bool IsRegionWet(int32 CellX, int32 CellY, int32 SizeCells) const;
+
+	FTimerHandle PatchUpdateHandle;
+
+	UPROPERTY()
+	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
+
+	/** Last pushed layout. Instances are only rebuilt when it changes. */
+	TArray<FTransform> CurrentPatchTransforms;
+
 	UPROPERTY()
 	TObjectPtr<UMaterialInstanceDynamic> DynamicMaterial;
 };
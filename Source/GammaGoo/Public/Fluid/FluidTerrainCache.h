@@ -0,0 +1,64 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// FFluidTerrainCache is the per-level on-disk terrain bake. Written by editor builds after a
+// traced bake, bulk-loaded at runtime so packaged clients and servers skip the traces entirely.
+// FFluidPrewarmCache sits next to it and holds the fluid an AFluidPrewarm run produced.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+struct GAMMAGOO_API FFluidTerrainCache
+{
+	/** Bump when the layout below changes. Older files are ignored and re-baked. */
+	static constexpr uint32 FileMagic = 0x43544C46; // "FLTC"
+	static constexpr uint32 FileVersion = 2;
+
+	/** Hash of the static collision the bake traced against, plus grid placement. */
+	uint64 GeometryHash = 0;
+	int32 GridSize = 0;
+	float CellWorldSize = 0.f;
+	FVector GridWorldOrigin = FVector::ZeroVector;
+
+	/** Row-major planes, GridSize * GridSize entries each. */
+	TArray<float> TerrainHeights;
+	TArray<uint8> NeighborMasks;
+
+	/** Loads Path and validates it against ExpectedHash. Returns false on any mismatch. */
+	bool Load(const FString& Path, uint64 ExpectedHash);
+	bool Save(const FString& Path) const;
+
+	/** Content/FluidCache/<MapName>.fluidterrain — staged with the build, see DefaultGame.ini. */
+	static FString GetCachePath(const UWorld* World);
+
+	/**
+	 * Hashes every static, collision-enabled primitive that blocks ECC_WorldStatic inside the
+	 * grid footprint, together with the grid placement. Any level edit that could move a
+	 * terrain trace hit changes the hash, including mesh collision rebuilds and landscape sculpts.
+	 * Paths are PIE-stripped so a cache written from PIE validates in -game and packaged builds.
+	 */
+	static uint64 ComputeGeometryHash(const UWorld* World, const FVector& GridWorldOrigin, float CellWorldSize, int32 GridSize);
+
+	friend FArchive& operator<<(FArchive& Ar, FFluidTerrainCache& Cache);
+};
+
+struct GAMMAGOO_API FFluidPrewarmCache
+{
+	static constexpr uint32 FileMagic = 0x57504C46; // "FLPW"
+	static constexpr uint32 FileVersion = 1;
+
+	/** Hash of the terrain, the pre-warm description and the sim tuning the run used. */
+	uint64 Key = 0;
+	int32 GridSize = 0;
+
+	/** Row-major, GridSize * GridSize entries. */
+	TArray<float> FluidVolumes;
+
+	/** Loads Path and validates it against ExpectedKey. Returns false on any mismatch. */
+	bool Load(const FString& Path, uint64 ExpectedKey);
+	bool Save(const FString& Path) const;
+
+	/** Content/FluidCache/<MapName>.fluidprewarm */
+	static FString GetCachePath(const UWorld* World);
+};
@@ -39,14 +39,322 @@ struct GAMMAGOO_API FFluidCell
 	FORCEINLINE float GetSurfaceHeight() const { return TerrainHeight + FluidVolume; }
 };
 
+/**
+ * Smooth fluid state at an arbitrary world position, bilinearly interpolated between
+ * the four surrounding cell centres. Returned by UFluidSubsystem::SampleFluidAtWorldPos.
+ */
+USTRUCT(BlueprintType)
+struct GAMMAGOO_API FFluidSample
+{
+	GENERATED_BODY()
+
+	/** Interpolated TerrainHeight + FluidVolume. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	float SurfaceHeight = 0.f;
+
+	/** Interpolated FluidVolume. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	float Depth = 0.f;
+
+	/** dSurface/dX, dSurface/dY in world units. Points uphill. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	FVector2D Gradient = FVector2D::ZeroVector;
+
+	/** Unit surface normal derived from Gradient. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	FVector Normal = FVector::UpVector;
+
+	/** Interpolated FlowVelocity. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	FVector2D FlowVelocity = FVector2D::ZeroVector;
+
+	/** False if the position is off the grid; every other field is then at its default. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	bool bValid = false;
+};
+
+/**
+ * Handle to a circular cell footprint registered with UFluidSubsystem::RegisterRegion.
+ * Stationary actors register once and pass the handle to the *InRegion calls.
+ */
+USTRUCT(BlueprintType)
+struct GAMMAGOO_API FFluidRegionHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** Guards against a released slot being reused by a later registration. */
+	UPROPERTY()
+	int32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+};
+
+/**
+ * Node of the terrain's depression tree, built by UFluidSubsystem once the terrain is baked.
+ * Leaves are the pits cells drain to; a merged node is two basins that pooled past their shared
+ * spill point and fill as one. Terrain only: levees and frozen cells are not considered.
+ */
+USTRUCT(BlueprintType)
+struct GAMMAGOO_API FFluidBasin
+{
+	GENERATED_BODY()
+
+	/** Lowest terrain in the basin. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	float PitHeight = 0.f;
+
+	/** Surface level at which the basin overflows. Float max for a root, which never spills. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	float SpillHeight = 0.f;
+
+	/** Fluid volume the basin holds when filled to SpillHeight. Float max for a root. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	float Capacity = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	int32 CellCount = 0;
+
+	/** Leaf basin the overflow runs into. INDEX_NONE for a root. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	int32 Downstream = INDEX_NONE;
+
+	/** Cell on this side of the spill point. INDEX_NONE for a root. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	int32 OutletCell = INDEX_NONE;
+
+	/** Merged basin this one becomes part of once full. INDEX_NONE for a root. */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Fluid")
+	int32 Parent = INDEX_NONE;
+
+	bool IsRoot() const { return Parent == INDEX_NONE; }
+};
+
+/** Area covered by a fluid watch. */
+UENUM(BlueprintType)
+enum class EFluidWatchShape : uint8
+{
+	Point	UMETA(DisplayName = "Point"),
+	Circle	UMETA(DisplayName = "Circle"),
+	Rect	UMETA(DisplayName = "Rectangle"),
+	Grid	UMETA(DisplayName = "Whole Grid"),
+	Basin	UMETA(DisplayName = "Basin")
+};
+
+/** Aggregate a fluid watch compares against its threshold. */
+UENUM(BlueprintType)
+enum class EFluidWatchMetric : uint8
+{
+	MaxDepth		UMETA(DisplayName = "Max Depth"),
+	TotalVolume		UMETA(DisplayName = "Total Volume"),
+	MaxSurfaceHeight	UMETA(DisplayName = "Max Surface Height")
+};
+
+/**
+ * A threshold watch over an area of the grid. Registered with UFluidSubsystem::AddFluidWatch;
+ * evaluated once per sim step alongside every other watch.
+ */
+USTRUCT(BlueprintType)
+struct GAMMAGOO_API FFluidWatchDesc
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	EFluidWatchShape Shape = EFluidWatchShape::Point;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	EFluidWatchMetric Metric = EFluidWatchMetric::MaxDepth;
+
+	/** World-space centre for Point, Circle and Rect. Basin watches use the basin under it unless BasinId is set. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	FVector Center = FVector::ZeroVector;
+
+	/** Circle radius in world units. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid", meta = (ClampMin = "0.0"))
+	float Radius = 0.f;
+
+	/** Rect half-size in world units. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	FVector2D HalfExtent = FVector2D::ZeroVector;
+
+	/** Basin to watch (see UFluidSubsystem::GetBasinInfo). INDEX_NONE uses the leaf basin under Center. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	int32 BasinId = INDEX_NONE;
+
+	/** Event fires with bAbove=true when the metric reaches this value. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	float Threshold = 0.f;
+
+	/** The metric must drop below Threshold - Hysteresis before bAbove=false fires. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid", meta = (ClampMin = "0.0"))
+	float Hysteresis = 0.f;
+
+	/** Also fire every step while above, for effects that scale with the current value. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Fluid")
+	bool bReportWhileAbove = false;
+};
+
+/** Modes for the batched fluid debug view. Selected with fluid.DebugDrawMode. */
+UENUM(BlueprintType)
+enum class EFluidDebugMode : uint8
+{
+	Depth			UMETA(DisplayName = "Depth"),
+	Velocity		UMETA(DisplayName = "Velocity"),
+	FrozenBlocked	UMETA(DisplayName = "Frozen / Blocked"),
+	ActiveTiles		UMETA(DisplayName = "Active Tiles"),
+	StepCost		UMETA(DisplayName = "Step Cost"),
+	Lakes			UMETA(DisplayName = "Lakes"),
+	Basins			UMETA(DisplayName = "Basins")
+};
+
+/** Where BakeTerrainHeights reads terrain from when no valid cache exists. */
+UENUM(BlueprintType)
+enum class EFluidTerrainSource : uint8
+{
+	Auto		UMETA(DisplayName = "Auto (Landscape, then traces)"),
+	Landscape	UMETA(DisplayName = "Landscape Heightmap"),
+	LineTrace	UMETA(DisplayName = "Line Traces")
+};
+
+/** How multiple heightmap samples inside one cell reduce to its TerrainHeight. */
+UENUM(BlueprintType)
+enum class EFluidTerrainFilter : uint8
+{
+	Mean	UMETA(DisplayName = "Mean"),
+	Min		UMETA(DisplayName = "Min"),
+	Max		UMETA(DisplayName = "Max")
+};
+
 /** Grid dimensions — single source of truth. */
 namespace FluidConstants
 {
 	constexpr int32 GridSize = 128;
 	constexpr int32 TotalCells = GridSize * GridSize;
+	constexpr int32 TileSize = 16;                   // Cells per tile edge (debug view, activity tracking)
+	constexpr int32 TilesPerSide = GridSize / TileSize;
+	constexpr int32 TotalTiles = TilesPerSide * TilesPerSide;
 	constexpr float DefaultCellWorldSize = 100.f;   // 100cm = 1 Unreal meter
 	constexpr float DefaultFlowRate = 0.25f;         // Viscosity control
 	constexpr float DefaultOscillationClamp = 0.5f;  // Max transfer fraction
 	constexpr float DefaultSimStepRate = 1.f / 30.f; // 30Hz fixed timestep
 	constexpr float DefaultVelocityDamping = 0.9f;  // Per-step multiplier. 0.9 = 10% decay per step.
+	constexpr float FlowEncodeRange = 500.f;         // Flow RT maps [-Range, +Range] to [0, 1]
+	constexpr float TerrainTraceHalfHeight = 100000.f; // Terrain bake traces run from +Z to -Z of this
+	constexpr int32 DefaultTerrainBakeBatchSize = 4096; // Async traces issued per frame during the bake
+	constexpr int32 MaxLandscapeSamplesPerAxis = 8;  // Caps heightmap samples per cell at 8x8
+	constexpr float TileSleepVolumeEpsilon = 0.01f;  // A tile sleeps once no cell's volume moves more than this per step
+	constexpr float TileSleepSpeedEpsilon = 1.f;     // ...and no cell's FlowVelocity exceeds this
+	constexpr float DefaultLakeDetectInterval = 0.5f; // Seconds between lake detection sweeps
+	constexpr float DefaultLakeFlatness = 0.5f;      // Max surface range (highest minus lowest) across one lake
+	constexpr float DefaultLakeMaxSpeed = 10.f;      // Cells flowing faster than this are never part of a lake
+	constexpr float DefaultLakeMinDepth = 2.f;       // Cells shallower than this are never part of a lake
+	constexpr int32 DefaultLakeMinCells = 32;        // Smaller flat pools are left to the cell sim
+	constexpr float LakeInteriorRewriteEpsilon = 0.05f; // A lake's held interior is rewritten once its level drifts this far
+	constexpr int32 ForecastCellsPerTexel = 4;       // Forecast delta texture resolution: 4x4 cells per texel
+	constexpr float DefaultPoolSolveInterval = 0.25f; // Seconds between coarse pool relaxation passes
+	constexpr int32 DefaultPoolSolveLevels = 4;       // Block sizes 4, 8, 16, 32 cells
+	constexpr float DefaultPoolRelaxation = 0.2f;     // Fraction of the block-pair surface gap closed per pass (<= 0.25 is stable)
+	constexpr float PrewarmPollInterval = 0.1f;       // Seconds between checks on the pre-warm worker during load
+	constexpr float DefaultRewindHistorySeconds = 10.f; // Sim seconds the rewind buffer keeps
+	constexpr int32 DefaultRewindKeyframeInterval = 30; // Steps between rewind keyframes (1s at 30Hz)
+	constexpr int32 DefaultRewindBudgetMB = 32;       // Encoded rewind history cap
+
+	// Cardinal neighbour offsets: East, West, North, South. Opposite direction is Dir ^ 1.
+	constexpr int32 NeighborDX[4] = { 1, -1, 0,  0 };
+	constexpr int32 NeighborDY[4] = { 0,  0, 1, -1 };
+	constexpr uint8 AllNeighborsOpen = 0x0F;
+
+	static_assert(GridSize % TileSize == 0, "GridSize must be a whole number of tiles");
+	static_assert(GridSize % ForecastCellsPerTexel == 0, "GridSize must be a whole number of forecast texels");
+}
+
+/**
+ * Cell storage order for Grid and every plane parallel to it. 0 = row-major, 1 = tiled (each
+ * TileSize^2 tile contiguous, row-major inside), 2 = Morton. The non-row-major layouts keep the
+ * +-Y neighbours of the flow stencil and the radius brushes on nearby cache lines; they pay for it
+ * only where data leaves the sim in row-major form (render uploads, debug textures, terrain cache).
+ * Set from the target's Build.cs, e.g. PublicDefinitions.Add("FLUID_CELL_LAYOUT=1").
+ */
+#ifndef FLUID_CELL_LAYOUT
+#define FLUID_CELL_LAYOUT 0
+#endif
+
+/** Cell index <-> coordinate mapping. All cell indexing goes through these; callers pass valid cells. */
+namespace FluidGrid
+{
+	using namespace FluidConstants;
+
+	static_assert(FLUID_CELL_LAYOUT != 2 || (GridSize & (GridSize - 1)) == 0, "Morton layout needs a power-of-two grid");
+
+	/** Moves the low 16 bits of V to the even bit positions. */
+	FORCEINLINE constexpr uint32 SpreadBits(uint32 V)
+	{
+		V &= 0x0000FFFF;
+		V = (V | (V << 8)) & 0x00FF00FF;
+		V = (V | (V << 4)) & 0x0F0F0F0F;
+		V = (V | (V << 2)) & 0x33333333;
+		V = (V | (V << 1)) & 0x55555555;
+		return V;
+	}
+
+	/** Inverse of SpreadBits. */
+	FORCEINLINE constexpr uint32 CompactBits(uint32 V)
+	{
+		V &= 0x55555555;
+		V = (V | (V >> 1)) & 0x33333333;
+		V = (V | (V >> 2)) & 0x0F0F0F0F;
+		V = (V | (V >> 4)) & 0x00FF00FF;
+		V = (V | (V >> 8)) & 0x0000FFFF;
+		return V;
+	}
+
+	FORCEINLINE constexpr int32 CellIndex(int32 X, int32 Y)
+	{
+#if FLUID_CELL_LAYOUT == 1
+		return ((Y / TileSize) * TilesPerSide + X / TileSize) * (TileSize * TileSize) + (Y % TileSize) * TileSize + X % TileSize;
+#elif FLUID_CELL_LAYOUT == 2
+		return static_cast<int32>(SpreadBits(X) | (SpreadBits(Y) << 1));
+#else
+		return Y * GridSize + X;
+#endif
+	}
+
+	FORCEINLINE constexpr int32 CellX(int32 Idx)
+	{
+#if FLUID_CELL_LAYOUT == 1
+		return ((Idx / (TileSize * TileSize)) % TilesPerSide) * TileSize + Idx % TileSize;
+#elif FLUID_CELL_LAYOUT == 2
+		return static_cast<int32>(CompactBits(Idx));
+#else
+		return Idx % GridSize;
+#endif
+	}
+
+	FORCEINLINE constexpr int32 CellY(int32 Idx)
+	{
+#if FLUID_CELL_LAYOUT == 1
+		return ((Idx / (TileSize * TileSize)) / TilesPerSide) * TileSize + (Idx % (TileSize * TileSize)) / TileSize;
+#elif FLUID_CELL_LAYOUT == 2
+		return static_cast<int32>(CompactBits(static_cast<uint32>(Idx) >> 1));
+#else
+		return Idx / GridSize;
+#endif
+	}
+
+	FORCEINLINE FIntPoint CellCoord(int32 Idx) { return FIntPoint(CellX(Idx), CellY(Idx)); }
+
+	/** Row-major tile (TilesPerSide^2 tiles) holding cell Idx, whatever the cell layout. */
+	FORCEINLINE constexpr int32 TileOfCell(int32 Idx)
+	{
+		return (CellY(Idx) / TileSize) * TilesPerSide + CellX(Idx) / TileSize;
+	}
+
+	/** Row-major position of cell Idx, for anything leaving the sim as an image or file. */
+	FORCEINLINE constexpr int32 RowMajorIndex(int32 Idx) { return CellY(Idx) * GridSize + CellX(Idx); }
+
+	static_assert(CellIndex(GridSize - 1, GridSize - 1) == TotalCells - 1, "Cell layout must be dense");
+	static_assert(CellX(CellIndex(37 % GridSize, 91 % GridSize)) == 37 % GridSize
+		&& CellY(CellIndex(37 % GridSize, 91 % GridSize)) == 91 % GridSize, "Cell layout must round-trip");
 }
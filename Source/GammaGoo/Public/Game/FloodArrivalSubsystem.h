@@ -0,0 +1,155 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// UFloodArrivalSubsystem estimates when fluid from the level's sources reaches each cell and the
+// Town Hall, without running the sim. The field is recomputed on a worker when terrain or sources change.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include <atomic>
+#include "FloodArrivalSubsystem.generated.h"
+
+class AFluidSource;
+class ATownHall;
+class UFluidSubsystem;
+class UTexture2D;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFloodArrivalUpdated);
+
+UCLASS()
+class GAMMAGOO_API UFloodArrivalSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- UWorldSubsystem interface ---
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Sources register for their lifetime. Placement is read once per recompute — sources must not move. */
+	void RegisterSource(AFluidSource* Source);
+	void UnregisterSource(AFluidSource* Source);
+
+	/** A new field has been applied. Fires on the game thread. */
+	UPROPERTY(BlueprintAssignable, Category = "Fluid|Arrival")
+	FOnFloodArrivalUpdated OnArrivalUpdated;
+
+	UFUNCTION(BlueprintPure, Category = "Fluid|Arrival")
+	bool IsArrivalFieldReady() const { return ArrivalTimes.Num() > 0; }
+
+	/**
+	 * Estimated seconds until fluid reaches WorldPos. Seeds are the active sources, or every
+	 * registered source while none are active, so build-phase queries preview the next wave.
+	 * Negative when unreachable, off-grid or not yet computed.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Arrival")
+	float GetArrivalTimeAtWorldPos(FVector WorldPos) const;
+
+	/** 1 where fluid arrives immediately, falling to 0 at ThreatHorizon seconds and beyond. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Arrival")
+	float GetThreatAtWorldPos(FVector WorldPos) const;
+
+	/** GetArrivalTimeAtWorldPos at the Town Hall. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Arrival")
+	float GetTownHallArrivalTime() const { return ToQueryTime(TownHallArrivalTime); }
+
+	/** Seconds for fluid from Source alone to reach the Town Hall, active or not. Negative if unreachable. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Arrival")
+	float GetSourceArrivalTime(const AFluidSource* Source) const;
+
+	/** GridSize^2 BGRA8 view of the field: red at arrival 0 fading to green at ThreatHorizon, clear if unreachable. */
+	UFUNCTION(BlueprintPure, Category = "Fluid|Arrival")
+	UTexture2D* GetArrivalDebugTexture() const { return DebugTexture; }
+
+protected:
+	/** Arrival time (seconds) at which threat reaches zero. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Arrival", meta = (ClampMin = "1.0"))
+	float ThreatHorizon = 60.f;
+
+	/** Front speed over flat ground (world units per second). Calibrate against the sim. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Arrival", meta = (ClampMin = "1.0"))
+	float FlatSpeed = 60.f;
+
+	/** Extra front speed per unit of downhill gradient (world units per second). */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Arrival", meta = (ClampMin = "0.0"))
+	float SlopeSpeed = 400.f;
+
+	/** Seconds per world unit the pooled surface must rise to spill over higher ground. */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Arrival", meta = (ClampMin = "0.0"))
+	float FillSecondsPerUnit = 0.5f;
+
+	/** How often inputs are checked for changes and finished jobs are collected (seconds). */
+	UPROPERTY(EditAnywhere, Category = "Fluid|Arrival", meta = (ClampMin = "0.05"))
+	float PollInterval = 0.25f;
+
+private:
+	/** Everything a recompute reads, snapshotted on the game thread. Owned by the job, never shared with the grid. */
+	struct FArrivalJob
+	{
+		TArray<float> TerrainHeights;
+		TArray<uint8> NeighborMasks;
+		TArray<TWeakObjectPtr<AFluidSource>> Sources;
+		TArray<int32> SourceCells;
+		TArray<int32> SeedCells;
+		int32 TownHallCell = INDEX_NONE;
+		float CellWorldSize = 0.f;
+		float FlatSpeed = 0.f;
+		float SlopeSpeed = 0.f;
+		float FillSecondsPerUnit = 0.f;
+		uint32 InputsKey = 0;
+
+		TArray<float> ArrivalTimes;
+		TArray<float> SourceTimes;
+
+		/** Set by the game thread when the inputs change mid-run. The worker bails at the next check. */
+		std::atomic<bool> bCancelled = false;
+	};
+
+	/** Worker body: the seeded field, then each source alone against the Town Hall. */
+	static void RunArrivalJob(FArrivalJob& Job);
+
+	/**
+	 * Dijkstra over the open-neighbour graph. Each edge costs the travel time across a cell plus
+	 * the time to fill up to any rise above the surface pooled so far along the path. Stops early
+	 * once StopCell is settled. Returns false if cancelled.
+	 */
+	static bool FloodFromSeeds(const FArrivalJob& Job, TConstArrayView<int32> Seeds, int32 StopCell, TArray<float>& OutTimes);
+
+	/** Timer: collects a finished job and launches a new one if the inputs moved on. */
+	void PollArrival();
+	uint32 ComputeInputsKey() const;
+	void LaunchJob(uint32 InputsKey);
+	void ApplyJob(FArrivalJob& Job);
+	void UpdateDebugTexture();
+
+	/** Unreachable cells hold FLT_MAX internally; queries report them as -1. */
+	static float ToQueryTime(float Time) { return Time < TNumericLimits<float>::Max() ? Time : -1.f; }
+	float SampleArrivalTime(FVector WorldPos) const;
+
+	UPROPERTY()
+	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
+
+	UPROPERTY()
+	TObjectPtr<UTexture2D> DebugTexture = nullptr;
+
+	TArray<TWeakObjectPtr<AFluidSource>> Sources;
+	TWeakObjectPtr<ATownHall> TownHall;
+
+	TSharedPtr<FArrivalJob, ESPMode::ThreadSafe> PendingJob;
+	UE::Tasks::FTask PendingTask;
+
+	/** Inputs the current field (or the job in flight) was built from. */
+	uint32 LaunchedKey = 0;
+	bool bLaunched = false;
+
+	TArray<float> ArrivalTimes;
+	float TownHallArrivalTime = TNumericLimits<float>::Max();
+
+	/** Parallel: the sources of the applied field and their Town Hall arrival times. */
+	TArray<TWeakObjectPtr<AFluidSource>> FieldSources;
+	TArray<float> FieldSourceTimes;
+
+	FTimerHandle PollHandle;
+};
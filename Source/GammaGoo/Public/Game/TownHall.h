@@ -22,6 +22,7 @@ public:
 	ATownHall();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UFUNCTION(BlueprintPure, Category = "TownHall")
 	float GetHealthPercent() const { return MaxHealth > 0.f ? Health / MaxHealth : 0.f; }
@@ -42,17 +43,16 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TownHall")
 	float MaxHealth = 1000.f;
 
-	/** Damage per second per cm of fluid depth above the base. */
+	/** Damage per second per cm of fluid depth above the base. Applied every sim step while flooded. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TownHall")
 	float DamagePerDepthPerSecond = 2.f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TownHall")
-	float DamageCheckInterval = 0.5f;
-
 private:
-	void CheckFluidDamage();
+	/** Fluid watch callback: fires each sim step while the surface is above BaseZ. */
+	UFUNCTION()
+	void OnFluidWatch(int32 WatchId, bool bAbove, float SurfaceHeight);
 
-	FTimerHandle DamageTimerHandle;
+	int32 FluidWatchId = INDEX_NONE;
 
 	UPROPERTY()
 	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
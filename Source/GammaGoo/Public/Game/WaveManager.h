@@ -106,9 +106,15 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave|Config")
 	float BasinTriggerThreshold = 5000.f;
 
-	/** How often the basin trigger volume check runs during a wave (seconds). */
+	/**
+	 * Optional: watch only the terrain basin under this actor instead of the whole grid. The trigger
+	 * then fires once that basin holds BasinTriggerFillFraction of its capacity.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave|Config")
-	float BasinCheckInterval = 1.f;
+	TObjectPtr<AActor> BasinTriggerMarker = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave|Config", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float BasinTriggerFillFraction = 0.5f;
 
 private:
 	// --- State -------------------------------------------------------------
@@ -136,10 +142,13 @@ private:
 
 	bool bBasinTriggeredThisWave = false;
 
+	/** Volume watch (whole grid, or the marker's basin), registered only while a basin-enabled wave runs. */
+	int32 BasinWatchId = INDEX_NONE;
+	float BasinWatchThreshold = 0.f;
+
 	// --- Timers ------------------------------------------------------------
 	FTimerHandle WaveDurationHandle;
 	FTimerHandle BuildPhaseHandle;
-	FTimerHandle BasinCheckHandle;
 
 	// --- Internal flow -----------------------------------------------------
 	void GatherWorldReferences();
@@ -150,9 +159,12 @@ private:
 	void DeactivateAllSources();
 	void ActivateSourcesForWave(const FWaveConfig& Config);
 	void ApplySpawnRateMultiplier(float Multiplier);
-	void CheckBasinTrigger();
+	void StopBasinWatch();
 	void TriggerVictory();
 
+	UFUNCTION()
+	void OnBasinWatch(int32 WatchId, bool bAbove, float TotalVolume);
+
 	UFUNCTION()
 	void OnTownDestroyed();
 };
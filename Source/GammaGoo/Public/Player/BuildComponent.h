@@ -8,6 +8,7 @@
 #include "BuildComponent.generated.h"
 
 class AFluidTowerBase;
+class UFluidForecastSubsystem;
 class UFluidSubsystem;
 class UResourceSubsystem;
 class UStaticMeshComponent;
@@ -51,6 +52,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Build")
 	float MaxFluidForPlacement = 5.f;
 
+	/** Request a with/without forecast from UFluidForecastSubsystem whenever the ghost changes cell or rotation. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Build")
+	bool bForecastPlacement = true;
+
 private:
 	bool bBuildModeActive = false;
 	int32 SelectedTowerIndex = 0;
@@ -67,7 +72,17 @@ private:
 	UPROPERTY()
 	TObjectPtr<UResourceSubsystem> ResourceSubsystem = nullptr;
 
+	UPROPERTY()
+	TObjectPtr<UFluidForecastSubsystem> ForecastSubsystem = nullptr;
+
+	/** Placement the current forecast was requested for, so a still ghost doesn't re-request. */
+	FIntPoint ForecastCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	int32 ForecastTowerIndex = INDEX_NONE;
+	FRotator ForecastRotation = FRotator::ZeroRotator;
+
 	void UpdateGhostPosition();
 	bool ValidatePlacement(const FVector& Location, const FHitResult& Hit) const;
 	void SetGhostColor(bool bValid);
+	void UpdateForecast();
+	void ClearForecast();
 };
@@ -15,6 +15,7 @@ class GAMMAGOO_API ACryoSpike : public AFluidTowerBase
 public:
 	ACryoSpike();
 	virtual void ExecuteEffect() override;
+	virtual void DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const override;
 
 protected:
 	/** How long the freeze persists before thawing. */
@@ -15,6 +15,7 @@ class GAMMAGOO_API AEvaporatorTower : public AFluidTowerBase
 public:
 	AEvaporatorTower();
 	virtual void ExecuteEffect() override;
+	virtual void DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const override;
 
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tower|Evaporator")
@@ -1,14 +1,17 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
-// Abstract base class for all defensive towers. Timer-driven effects, never Tick.
+// Abstract base class for all defensive towers. Effects are scheduled by UTowerEffectSubsystem, never Tick.
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Fluid/FluidTypes.h"
 #include "FluidTowerBase.generated.h"
 
 class UFluidSubsystem;
+class UTowerEffectSubsystem;
 class UStaticMeshComponent;
+struct FFluidForecastEdit;
 
 UCLASS(Abstract, BlueprintType, Blueprintable)
 class GAMMAGOO_API AFluidTowerBase : public AActor
@@ -21,10 +24,16 @@ public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	/** Override in subclasses to apply tower-specific effect. */
+	/** Override in subclasses to apply tower-specific effect. Called every EffectInterval on a fluid step. */
 	UFUNCTION(BlueprintCallable, Category = "Tower")
 	virtual void ExecuteEffect();
 
+	/**
+	 * What placing this tower at Location would change, for build-preview forecasts. Called on
+	 * the class default object, so it reads tuning only. Default: nothing the flow step sees.
+	 */
+	virtual void DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const {}
+
 	UFUNCTION(BlueprintCallable, Category = "Tower")
 	void ApplyDamage(float DamageAmount);
 
@@ -34,6 +43,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Tower")
 	bool IsAlive() const { return Health > 0.f; }
 
+	/** Fluid volume this tower has destroyed since it was built. */
+	UFUNCTION(BlueprintPure, Category = "Tower")
+	float GetTotalFluidRemoved() const { return TotalFluidRemoved; }
+
 protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Tower")
 	TObjectPtr<UStaticMeshComponent> TowerMesh;
@@ -56,8 +69,26 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
 
+	/** Adds to this tower's and the match-wide removal totals. Pass the value returned by the removal call. */
+	void RecordFluidRemoved(float Volume);
+
+	/**
+	 * Collects the volume credited to this tower by queued removals resolved since the last
+	 * call, records it, and returns it. Queued removals resolve at the next fluid step.
+	 */
+	float ConsumeResolvedRemoval();
+
+	/** Attribution id for queued removals. */
+	int32 EffectContributorId = INDEX_NONE;
+
+	/** EffectRadius footprint at the tower's BeginPlay location. Towers don't move, so it's built once. */
+	FFluidRegionHandle FluidRegion;
+
 private:
-	FTimerHandle EffectTimerHandle;
+	UPROPERTY()
+	TObjectPtr<UTowerEffectSubsystem> TowerEffectSubsystem = nullptr;
+
+	float TotalFluidRemoved = 0.f;
 
 	void OnDestroyed_Internal();
 };
@@ -17,6 +17,7 @@ public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void ExecuteEffect() override;
+	virtual void DescribeForecastEdit(const UFluidSubsystem& Fluid, const FVector& Location, const FRotator& Rotation, FFluidForecastEdit& OutEdit) const override;
 
 protected:
 	/** Number of cells this wall spans along its forward axis. */
@@ -28,4 +29,7 @@ private:
 	TArray<FIntPoint> OccupiedCells;
 
 	void BlockCells(bool bBlock);
+
+	/** Cells a wall at Location facing Forward would occupy. Shared by BeginPlay and the forecast. */
+	void ComputeWallCells(const UFluidSubsystem& Fluid, const FVector& Location, const FVector& Forward, TArray<FIntPoint>& OutCells) const;
 };
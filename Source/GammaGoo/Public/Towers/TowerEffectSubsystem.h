@@ -0,0 +1,85 @@
+// Copyright 2026 Bret Wright. All Rights Reserved.
+// UTowerEffectSubsystem runs every tower's effect from the fluid sim step instead of per-tower timers.
+// Towers are grouped by class so each type's effects run back to back in a fixed order.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TowerEffectSubsystem.generated.h"
+
+class AFluidTowerBase;
+class UFluidSubsystem;
+
+UCLASS()
+class GAMMAGOO_API UTowerEffectSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// --- UWorldSubsystem interface ---
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Tower's ExecuteEffect will run every Interval seconds of simulated time, on a step boundary.
+	 * Calls made while effects are running (a tower spawning or killing another) land after the sweep.
+	 */
+	void RegisterTower(AFluidTowerBase* Tower, float Interval);
+	void UnregisterTower(AFluidTowerBase* Tower);
+
+	UFUNCTION(BlueprintPure, Category = "Tower")
+	int32 GetRegisteredTowerCount() const;
+
+	/** Fluid volume destroyed by all towers this match, as reported by the towers themselves. */
+	UFUNCTION(BlueprintPure, Category = "Tower")
+	float GetTotalFluidRemoved() const { return TotalFluidRemoved; }
+
+	/** Called by towers after a removal effect with the exact volume the subsystem returned. */
+	void ReportFluidRemoved(float Volume) { TotalFluidRemoved += Volume; }
+
+private:
+	/** Advances every tower's accumulator by one fluid step and runs the ones that are due. */
+	void OnFluidPreStep(float StepSeconds);
+
+	void AddTower(AFluidTowerBase* Tower, float Interval);
+	void RemoveTower(const UClass* Class, const TWeakObjectPtr<AFluidTowerBase>& Tower);
+
+	struct FTowerEntry
+	{
+		TWeakObjectPtr<AFluidTowerBase> Tower;
+		float Interval = 0.f;
+		float Accumulator = 0.f;
+	};
+
+	/** All towers of one class, in registration order. */
+	struct FTowerGroup
+	{
+		const UClass* Class = nullptr;
+		TArray<FTowerEntry> Entries;
+	};
+
+	/** Groups in first-registration order, so effect order is stable for a given build sequence. */
+	TArray<FTowerGroup> Groups;
+
+	/** Scratch for towers due this step, reused to avoid per-step allocation. */
+	TArray<AFluidTowerBase*> DueTowers;
+
+	/** Register / unregister calls made during the sweep, applied in call order once it ends. */
+	struct FPendingChange
+	{
+		TWeakObjectPtr<AFluidTowerBase> Tower;
+		const UClass* Class = nullptr;
+		float Interval = 0.f;
+		bool bAdd = false;
+	};
+	TArray<FPendingChange> PendingChanges;
+	bool bSweeping = false;
+
+	UPROPERTY()
+	TObjectPtr<UFluidSubsystem> FluidSubsystem = nullptr;
+
+	FDelegateHandle PreStepHandle;
+
+	float TotalFluidRemoved = 0.f;
+};
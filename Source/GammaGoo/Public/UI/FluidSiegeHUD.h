@@ -1,5 +1,5 @@
 // Copyright 2026 Bret Wright. All Rights Reserved.
-// UFluidSiegeHUD displays wave state, resources, Town Hall health, and player energy via NativeTick polling.
+// UFluidSiegeHUD displays wave state, resources, Town Hall health, player energy and fluid destroyed via NativeTick polling.
 
 #pragma once
 
@@ -9,6 +9,7 @@
 
 class AWaveManager;
 class UResourceSubsystem;
+class UTowerEffectSubsystem;
 class ATownHall;
 class AFluidDefenseCharacter;
 class UTextBlock;
@@ -53,6 +54,10 @@ protected:
 	UPROPERTY(meta = (BindWidgetOptional))
 	TObjectPtr<UProgressBar> EnergyBar;
 
+	/** Total fluid volume destroyed by towers this match. */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> FluidDestroyedText;
+
 private:
 	void CacheReferences();
 
@@ -62,6 +67,9 @@ private:
 	UPROPERTY()
 	TObjectPtr<UResourceSubsystem> CachedResourceSubsystem = nullptr;
 
+	UPROPERTY()
+	TObjectPtr<UTowerEffectSubsystem> CachedTowerEffectSubsystem = nullptr;
+
 	UPROPERTY()
 	TObjectPtr<ATownHall> CachedTownHall = nullptr;
 